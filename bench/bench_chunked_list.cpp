@@ -0,0 +1,300 @@
+// Google Benchmark suite comparing ChunkedList with std::vector, std::deque and std::list.
+// Arguments of every benchmark: item count / position in percent / chunk size (0 for std containers)
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "chunked_list.hpp"
+
+using container::chunked_list::ChunkedList;
+
+// Item of N bytes, the first word is used as key
+template <size_t N>
+struct Item {
+    uint64_t words[N / sizeof(uint64_t)];
+
+    Item() : Item(0) {}
+    explicit Item(uint64_t key) {
+        for (uint64_t& word : words) {
+            word = key;
+        }
+    }
+};
+
+// Container construction, the chunk size is only used by ChunkedList
+template <typename C>
+struct Factory {
+    static C* create(const benchmark::State&) { return new C(); }
+};
+
+template <typename T>
+struct Factory<ChunkedList<T>> {
+    static ChunkedList<T>* create(const benchmark::State& state) { return new ChunkedList<T>((size_t)state.range(2)); }
+};
+
+// Uniform access to the operations of the compared containers
+template <typename T> void push_item(std::vector<T>& c, const T& item) { c.push_back(item); }
+template <typename T> void push_item(std::deque<T>& c, const T& item) { c.push_back(item); }
+template <typename T> void push_item(std::list<T>& c, const T& item) { c.push_back(item); }
+template <typename T> void push_item(ChunkedList<T>& c, const T& item) { c.add(item); }
+
+template <typename T> void emplace_item(std::vector<T>& c, uint64_t key) { c.emplace_back(key); }
+template <typename T> void emplace_item(std::deque<T>& c, uint64_t key) { c.emplace_back(key); }
+template <typename T> void emplace_item(std::list<T>& c, uint64_t key) { c.emplace_back(key); }
+template <typename T> void emplace_item(ChunkedList<T>& c, uint64_t key) { c.emplace(key); }
+
+template <typename T> T& item_at(std::vector<T>& c, size_t index) { return c[index]; }
+template <typename T> T& item_at(std::deque<T>& c, size_t index) { return c[index]; }
+template <typename T> T& item_at(std::list<T>& c, size_t index) { return *std::next(c.begin(), index); }
+template <typename T> T& item_at(ChunkedList<T>& c, size_t index) { return c[index]; }
+
+template <typename T> void remove_at(std::vector<T>& c, size_t index) { c.erase(c.begin() + index); }
+template <typename T> void remove_at(std::deque<T>& c, size_t index) { c.erase(c.begin() + index); }
+template <typename T> void remove_at(std::list<T>& c, size_t index) { c.erase(std::next(c.begin(), index)); }
+template <typename T> void remove_at(ChunkedList<T>& c, size_t index) { c.remove(index); }
+
+template <typename C>
+static std::unique_ptr<C> make_filled(const benchmark::State& state) {
+    std::unique_ptr<C> c(Factory<C>::create(state));
+    for (int64_t idx = 0; idx < state.range(0); ++idx) {
+        emplace_item(*c, (uint64_t)idx);
+    }
+    return c;
+}
+
+// Index at the given percentage of a container of size items
+static size_t position_index(size_t size, int64_t percent) {
+    return size ? (size - 1) * (size_t)percent / 100 : 0;
+}
+
+template <typename C>
+static void BM_Add(benchmark::State& state) {
+    typename C::value_type item(42);
+    for (auto _ : state) {
+        std::unique_ptr<C> c(Factory<C>::create(state));
+        for (int64_t idx = 0; idx < state.range(0); ++idx) {
+            push_item(*c, item);
+        }
+        benchmark::DoNotOptimize(c.get());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Appending after reserving the capacity, only for containers with reserve()
+template <typename C>
+static void BM_AddReserved(benchmark::State& state) {
+    typename C::value_type item(42);
+    for (auto _ : state) {
+        std::unique_ptr<C> c(Factory<C>::create(state));
+        c->reserve((size_t)state.range(0));
+        for (int64_t idx = 0; idx < state.range(0); ++idx) {
+            push_item(*c, item);
+        }
+        benchmark::DoNotOptimize(c.get());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename C>
+static void BM_Emplace(benchmark::State& state) {
+    for (auto _ : state) {
+        std::unique_ptr<C> c(Factory<C>::create(state));
+        for (int64_t idx = 0; idx < state.range(0); ++idx) {
+            emplace_item(*c, (uint64_t)idx);
+        }
+        benchmark::DoNotOptimize(c.get());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename C>
+static void BM_At(benchmark::State& state) {
+    std::unique_ptr<C> c = make_filled<C>(state);
+    size_t index = position_index((size_t)state.range(0), state.range(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(&item_at(*c, index));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename C>
+static void BM_Iterate(benchmark::State& state) {
+    std::unique_ptr<C> c = make_filled<C>(state);
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        for (auto& item : *c) {
+            sum += item.words[0];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Iteration through the C iterator API, only applicable to the chunked list
+template <typename T>
+static void BM_IterateC(benchmark::State& state) {
+    CHUNKED_LIST_HANDLE list = chunked_list_create(sizeof(T), (size_t)state.range(2));
+    T item(1);
+    for (int64_t idx = 0; idx < state.range(0); ++idx) {
+        chunked_list_add(list, &item);
+    }
+
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        CHUNKED_LIST_ITERATOR_HANDLE iter = chunked_list_iterator_create(list);
+        T* current;
+        while (chunked_list_iterator_is_end(iter) != 1) {
+            chunked_list_iterator_get(iter, (void**)&current);
+            sum += current->words[0];
+            chunked_list_iterator_next(iter);
+        }
+        chunked_list_iterator_destroy(iter);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    chunked_list_destroy(list);
+}
+
+// Iteration over a list whose chunks were allocated in between other allocations, the position
+// argument moves the chunks into contiguous slabs (1) before iterating or leaves them scattered (0).
+// Run it from a build with PREFETCH=0 to compare with iterators that do not prefetch
+template <typename T>
+static void BM_IterateScattered(benchmark::State& state) {
+#ifdef CHUNKED_LIST_NO_PREFETCH
+    state.SetLabel("no prefetch");
+#else
+    state.SetLabel("prefetch");
+#endif
+    size_t chunk_size = (size_t)state.range(2);
+    size_t chunk_count = (size_t)state.range(0) * sizeof(T) / chunk_size + 1;
+
+    // Chunk-sized holes in random order, kept apart by live blocks so that the allocator cannot merge them
+    std::vector<void*> holes;
+    std::vector<void*> live;
+    for (size_t idx = 0; idx < chunk_count; ++idx) {
+        holes.push_back(malloc(chunk_size + 128));
+        live.push_back(malloc(64));
+    }
+    std::shuffle(holes.begin(), holes.end(), std::mt19937(42));
+    for (void* hole : holes) {
+        free(hole);
+    }
+
+    ChunkedList<T> list(chunk_size);
+    for (int64_t idx = 0; idx < state.range(0); ++idx) {
+        list.emplace((uint64_t)idx);
+    }
+    if (state.range(1)) {
+        list.relayout();
+    }
+
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        for (auto& item : list) {
+            sum += item.words[0];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    for (void* block : live) {
+        free(block);
+    }
+}
+
+// Parallel scan with one worker per node, the position argument selects the NUMA policy of the chunks
+template <typename T>
+static void BM_ScanParallel(benchmark::State& state) {
+    ChunkedList<T> list((size_t)state.range(2));
+    list.set_numa_policy((int)state.range(1));
+    for (int64_t idx = 0; idx < state.range(0); ++idx) {
+        list.emplace((uint64_t)idx);
+    }
+
+    for (auto _ : state) {
+        std::atomic<uint64_t> sum(0);
+        list.scan_parallel(1, [&sum](const T& item, size_t) { sum.fetch_add(item.words[0], std::memory_order_relaxed); });
+        benchmark::DoNotOptimize(sum.load());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename C>
+static void BM_Remove(benchmark::State& state) {
+    const size_t REMOVE_COUNT = 1000;
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::unique_ptr<C> c = make_filled<C>(state);
+        size_t size = (size_t)state.range(0);
+        state.ResumeTiming();
+
+        for (size_t idx = 0; idx < REMOVE_COUNT && size > 0; ++idx, --size) {
+            remove_at(*c, position_index(size, state.range(1)));
+        }
+
+        state.PauseTiming();
+        c.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * REMOVE_COUNT);
+}
+
+template <typename C>
+static void BM_ClearRefill(benchmark::State& state) {
+    std::unique_ptr<C> c = make_filled<C>(state);
+    for (auto _ : state) {
+        c->clear();
+        for (int64_t idx = 0; idx < state.range(0); ++idx) {
+            emplace_item(*c, (uint64_t)idx);
+        }
+        benchmark::DoNotOptimize(c.get());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static const std::vector<int64_t> kItemCounts = { 100000 };
+static const std::vector<int64_t> kNoPosition = { 0 };
+static const std::vector<int64_t> kPositions = { 0, 50, 100 };
+static const std::vector<int64_t> kChunkSizes = { 1024, 16 * 1024, 64 * 1024 };
+static const std::vector<int64_t> kNoChunkSize = { 0 };
+
+#define REGISTER_FOR_ITEM(Func, ItemType, Positions)                                                        \
+    BENCHMARK_TEMPLATE(Func, ChunkedList<ItemType>)->ArgsProduct({ kItemCounts, Positions, kChunkSizes });  \
+    BENCHMARK_TEMPLATE(Func, std::vector<ItemType>)->ArgsProduct({ kItemCounts, Positions, kNoChunkSize }); \
+    BENCHMARK_TEMPLATE(Func, std::deque<ItemType>)->ArgsProduct({ kItemCounts, Positions, kNoChunkSize });  \
+    BENCHMARK_TEMPLATE(Func, std::list<ItemType>)->ArgsProduct({ kItemCounts, Positions, kNoChunkSize });
+
+#define REGISTER_BENCHMARK(Func, Positions)        \
+    REGISTER_FOR_ITEM(Func, Item<8>, Positions)    \
+    REGISTER_FOR_ITEM(Func, Item<64>, Positions)   \
+    REGISTER_FOR_ITEM(Func, Item<256>, Positions)
+
+REGISTER_BENCHMARK(BM_Add, kNoPosition)
+REGISTER_BENCHMARK(BM_Emplace, kNoPosition)
+REGISTER_BENCHMARK(BM_At, kPositions)
+REGISTER_BENCHMARK(BM_Iterate, kNoPosition)
+REGISTER_BENCHMARK(BM_Remove, kPositions)
+REGISTER_BENCHMARK(BM_ClearRefill, kNoPosition)
+
+BENCHMARK_TEMPLATE(BM_AddReserved, ChunkedList<Item<64>>)->ArgsProduct({ kItemCounts, kNoPosition, kChunkSizes });
+BENCHMARK_TEMPLATE(BM_AddReserved, std::vector<Item<64>>)->ArgsProduct({ kItemCounts, kNoPosition, kNoChunkSize });
+
+BENCHMARK_TEMPLATE(BM_IterateC, Item<8>)->ArgsProduct({ kItemCounts, kNoPosition, kChunkSizes });
+BENCHMARK_TEMPLATE(BM_IterateC, Item<64>)->ArgsProduct({ kItemCounts, kNoPosition, kChunkSizes });
+BENCHMARK_TEMPLATE(BM_IterateC, Item<256>)->ArgsProduct({ kItemCounts, kNoPosition, kChunkSizes });
+
+static const std::vector<int64_t> kScatteredItemCounts = { 1000000 };
+static const std::vector<int64_t> kRelayout = { 0, 1 };
+BENCHMARK_TEMPLATE(BM_IterateScattered, Item<64>)->ArgsProduct({ kScatteredItemCounts, kRelayout, kChunkSizes });
+
+static const std::vector<int64_t> kNumaPolicies = { CHUNKED_LIST_NUMA_LOCAL, CHUNKED_LIST_NUMA_INTERLEAVE };
+BENCHMARK_TEMPLATE(BM_ScanParallel, Item<64>)->ArgsProduct({ kItemCounts, kNumaPolicies, kChunkSizes })->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,86 @@
+// Compares a full scan against a zone map range scan on timestamp-ordered items.
+// Usage: bench_scan_range [item_count] [window_percent]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "chunked_list.h"
+#include "chunked_list_iterator.h"
+#include "chunked_list_scan.h"
+
+struct Event {
+    int64_t timestamp;
+    uint32_t value;
+    uint32_t flags;
+};
+
+static int64_t event_timestamp(const void* item) {
+    return ((const Event*)item)->timestamp;
+}
+
+static int sum_values(void* item, size_t, void* context) {
+    *(uint64_t*)context += ((Event*)item)->value;
+    return 0;
+}
+
+static double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? strtoull(argv[1], nullptr, 10) : 1000000ULL;
+    double window_percent = argc > 2 ? atof(argv[2]) : 1.0;
+
+    CHUNKED_LIST_HANDLE list = chunked_list_create(sizeof(Event), CHUNKED_LIST_CHUNK_SIZE);
+    if (!list) {
+        fprintf(stderr, "Failed to create chunked_list.\n");
+        return 1;
+    }
+
+    // Mostly ordered timestamps with a little jitter
+    int64_t timestamp = 0;
+    for (size_t idx = 0; idx < count; ++idx) {
+        timestamp += 1 + (int64_t)(idx % 7 == 0 ? 3 : 0);
+        Event event = { timestamp - (int64_t)(idx % 5), (uint32_t)idx, 0 };
+        if (chunked_list_add(list, &event) != CHUNKED_LIST_SUCCESS) {
+            fprintf(stderr, "Failed to add item %zu.\n", idx);
+            return 1;
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    chunked_list_set_key_extractor(list, event_timestamp);
+    double summary_ms = elapsed_ms(start);
+
+    int64_t min_key = (int64_t)(timestamp * 0.5);
+    int64_t max_key = min_key + (int64_t)(timestamp * window_percent / 100.0);
+
+    // Baseline: iterate over every item and filter
+    uint64_t full_sum = 0;
+    start = std::chrono::steady_clock::now();
+    CHUNKED_LIST_ITERATOR_HANDLE iter = chunked_list_iterator_create(list);
+    Event* event;
+    while (chunked_list_iterator_is_end(iter) != 1) {
+        chunked_list_iterator_get(iter, (void**)&event);
+        if (event->timestamp >= min_key && event->timestamp <= max_key) {
+            full_sum += event->value;
+        }
+        chunked_list_iterator_next(iter);
+    }
+    chunked_list_iterator_destroy(iter);
+    double full_ms = elapsed_ms(start);
+
+    uint64_t range_sum = 0;
+    start = std::chrono::steady_clock::now();
+    chunked_list_scan_range(list, min_key, max_key, sum_values, &range_sum);
+    double range_ms = elapsed_ms(start);
+
+    printf("items: %zu, window: %.2f%%\n", count, window_percent);
+    printf("summary build:  %10.2f ms\n", summary_ms);
+    printf("full scan:      %10.2f ms (sum %llu)\n", full_ms, (unsigned long long)full_sum);
+    printf("range scan:     %10.2f ms (sum %llu)\n", range_ms, (unsigned long long)range_sum);
+    printf("speedup:        %10.2fx\n", full_ms / range_ms);
+
+    chunked_list_destroy(list);
+    return full_sum == range_sum ? 0 : 1;
+}
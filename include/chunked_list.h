@@ -16,9 +16,21 @@ extern "C" {
 /// Error code for memory allocation failure
 #define CHUNKED_LIST_ERROR_ALLOCATION_FAILED -2
 
+/// Error code for an operation the list is not configured for
+#define CHUNKED_LIST_ERROR_INVALID_OPERATION -3
+
 /// Chunk size definition (16 KB)
 #define CHUNKED_LIST_CHUNK_SIZE (16 * 1024)
 
+/// Flag for chunked_list_create_ex: items have individual sizes, see chunked_list_bytes.h
+#define CHUNKED_LIST_FLAG_VARIABLE_LENGTH 0x1
+
+/// Flag for chunked_list_create_ex: readers may run concurrently with one writer, see chunked_list_readers.h
+#define CHUNKED_LIST_FLAG_READER_SAFE 0x2
+
+/// Flag for chunked_list_create_ex: removed items leave reusable slots, items have stable handles, see chunked_list_slots.h
+#define CHUNKED_LIST_FLAG_SLOT_MAP 0x4
+
 /// Opaque type for the chunked list handle
 typedef void* CHUNKED_LIST_HANDLE;
 
@@ -33,6 +45,29 @@ typedef void* CHUNKED_LIST_HANDLE;
  */
 CHUNKED_LIST_HANDLE chunked_list_create(size_t item_size, size_t chunk_size);
 
+/**
+ * @brief Creates a new chunked list container with optional features.
+ *
+ * Same as chunked_list_create, with a combination of CHUNKED_LIST_FLAG_* values selecting
+ * the mode of the list.
+ *
+ * @param item_size The size of each item in the list, ignored in variable-length mode.
+ * @param chunk_size The size of each chunk in the list.
+ * @param flags A combination of CHUNKED_LIST_FLAG_* values, 0 for a plain list.
+ * @return A handle to the new chunked list, or NULL if memory allocation fails or the flags cannot be combined
+ *         (at most one of CHUNKED_LIST_FLAG_VARIABLE_LENGTH, CHUNKED_LIST_FLAG_READER_SAFE and
+ *         CHUNKED_LIST_FLAG_SLOT_MAP), or if a slot-map chunk cannot hold a single item.
+ */
+CHUNKED_LIST_HANDLE chunked_list_create_ex(size_t item_size, size_t chunk_size, unsigned flags);
+
+/**
+ * @brief Gets the flags the chunked list was created with.
+ *
+ * @param list A handle to the chunked list.
+ * @return The combination of CHUNKED_LIST_FLAG_* values passed to chunked_list_create_ex, 0 for a plain list.
+ */
+unsigned chunked_list_flags(CHUNKED_LIST_HANDLE list);
+
 /**
  * @brief Deletes a chunked list and frees all resources.
  *
@@ -51,7 +86,8 @@ int chunked_list_destroy(CHUNKED_LIST_HANDLE list);
  * @param list A handle to the chunked list.
  * @param index The index of the item to retrieve.
  * @param item Pointer to a pointer where the retrieved item will be stored.
- * @return CHUNKED_LIST_SUCCESS on success, or CHUNKED_LIST_ERROR_INVALID_INDEX if the index is out of range.
+ * @return CHUNKED_LIST_SUCCESS on success, CHUNKED_LIST_ERROR_INVALID_INDEX if the index is out of range,
+ *         or CHUNKED_LIST_ERROR_ALLOCATION_FAILED if the chunk holding the item is compressed and decompressing it fails.
  */
 int chunked_list_at(CHUNKED_LIST_HANDLE list, size_t index, void** item);
 
@@ -59,33 +95,54 @@ int chunked_list_at(CHUNKED_LIST_HANDLE list, size_t index, void** item);
  * @brief Expands the chunked list for a new item.
  *
  * Expands the chunked list for a new item and return the address of the item back.
+ * In slot-map mode a free slot is reused before the list grows.
  *
  * @param list A handle to the chunked list.
  * @param item Pointer to a pointer where the retrieved item will be stored.
- * @return CHUNKED_LIST_SUCCESS on success, or CHUNKED_LIST_ERROR_ALLOCATION_FAILED if memory allocation fails.
+ * @return CHUNKED_LIST_SUCCESS on success, CHUNKED_LIST_ERROR_ALLOCATION_FAILED if memory allocation fails,
+ *         or CHUNKED_LIST_ERROR_INVALID_OPERATION in variable-length and reader-safe mode, where readers
+ *         would see the item before it is written.
  */
 int chunked_list_expand(CHUNKED_LIST_HANDLE list, void** pnewItem);
 
 /**
  * @brief Adds a new item to the chunked list.
  *
- * Adds the provided item to the end of the chunked list.
+ * Adds the provided item to the end of the chunked list, or to a free slot in slot-map mode.
  *
  * @param list A handle to the chunked list.
  * @param item A pointer to the item to be added.
- * @return CHUNKED_LIST_SUCCESS on success, or CHUNKED_LIST_ERROR_ALLOCATION_FAILED if memory allocation fails.
+ * @return CHUNKED_LIST_SUCCESS on success, CHUNKED_LIST_ERROR_ALLOCATION_FAILED if memory allocation fails,
+ *         or CHUNKED_LIST_ERROR_INVALID_OPERATION in variable-length mode.
  */
 int chunked_list_add(CHUNKED_LIST_HANDLE list, void* item);
 
+/**
+ * @brief Inserts a new item at a specific index.
+ *
+ * Items after the index in the same chunk are shifted to make room. A full chunk is split
+ * in two halves first, other chunks remain unaffected.
+ *
+ * @param list A handle to the chunked list.
+ * @param index The index of the new item, chunked_list_count(list) appends it.
+ * @param pnewItem Pointer to a pointer where the address of the new item will be stored.
+ * @return CHUNKED_LIST_SUCCESS on success, CHUNKED_LIST_ERROR_INVALID_INDEX if the index is out of range,
+ *         CHUNKED_LIST_ERROR_ALLOCATION_FAILED if memory allocation fails, or CHUNKED_LIST_ERROR_INVALID_OPERATION
+ *         in variable-length, reader-safe and slot-map mode.
+ */
+int chunked_list_insert(CHUNKED_LIST_HANDLE list, size_t index, void** pnewItem);
+
 /**
  * @brief Removes an item from the chunked list chunked_list_at a specific index.
  *
  * Removes the item located chunked_list_at the specified index. The items in the same chunk are
- * shifted to fill the gap, but other chunks remain unaffected.
+ * shifted to fill the gap, but other chunks remain unaffected. In slot-map mode nothing is
+ * shifted, the item leaves a free slot behind.
  *
  * @param list A handle to the chunked list.
  * @param index The index of the item to chunked_list_remove.
- * @return CHUNKED_LIST_SUCCESS on success, or CHUNKED_LIST_ERROR_INVALID_INDEX if the index is out of range.
+ * @return CHUNKED_LIST_SUCCESS on success, CHUNKED_LIST_ERROR_INVALID_INDEX if the index is out of range,
+ *         or CHUNKED_LIST_ERROR_ALLOCATION_FAILED if a chunk shared with a snapshot or compressed cannot be copied.
  */
 int chunked_list_remove(CHUNKED_LIST_HANDLE list, size_t index);
 
@@ -95,10 +152,36 @@ int chunked_list_remove(CHUNKED_LIST_HANDLE list, size_t index);
  * Removes all items from the chunked list, effectively resetting it.
  *
  * @param list A handle to the chunked list.
- * @return CHUNKED_LIST_SUCCESS on success, or an error code on failure.
+ * @return CHUNKED_LIST_SUCCESS on success, or CHUNKED_LIST_ERROR_ALLOCATION_FAILED if the chunks of a
+ *         reader-safe list cannot be queued for reclamation, in which case the list is left unchanged.
  */
 int chunked_list_clear(CHUNKED_LIST_HANDLE list);
 
+/**
+ * @brief Pre-allocates chunks so the list can hold at least n_items items.
+ *
+ * The missing chunks are carved from a single allocation and kept aside until appends
+ * need them, so chunked_list_add and chunked_list_expand do not allocate memory until
+ * the list holds n_items items. chunked_list_clear releases the reserved chunks.
+ *
+ * @param list A handle to the chunked list.
+ * @param n_items The number of items the list must be able to hold.
+ * @return CHUNKED_LIST_SUCCESS on success, CHUNKED_LIST_ERROR_ALLOCATION_FAILED if memory allocation fails,
+ *         or CHUNKED_LIST_ERROR_INVALID_OPERATION in variable-length mode.
+ */
+int chunked_list_reserve(CHUNKED_LIST_HANDLE list, size_t n_items);
+
+/**
+ * @brief Gets the capacity of the chunked list.
+ *
+ * Returns the number of items the list can hold before appending allocates memory. In
+ * variable-length mode the capacity depends on the item sizes and the item count is returned.
+ *
+ * @param list A handle to the chunked list.
+ * @return The capacity of the list in items.
+ */
+size_t chunked_list_capacity(CHUNKED_LIST_HANDLE list);
+
 /**
  * @brief Gets the number of items in the chunked list.
  *
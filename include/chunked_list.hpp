@@ -1,25 +1,58 @@
 #ifndef CHUNKED_LIST_HPP
 #define CHUNKED_LIST_HPP
 
+#include <cstddef>
+#include <functional>
 #include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#if defined(__has_include)
+#if __has_include(<span>)
+#include <span>
+#endif
+#endif
 #include "chunked_list.h"  
+#include "chunked_list_bytes.h"
+#include "chunked_list_compress.h"
 #include "chunked_list_iterator.h"
+#include "chunked_list_layout.h"
+#include "chunked_list_numa.h"
+#include "chunked_list_readers.h"
+#include "chunked_list_scan.h"
+#include "chunked_list_slots.h"
+#include "chunked_list_snapshot.h"
+#include "chunked_list_sorted.h"
+#include "chunked_list_stats.h"
 
 namespace container {
 	namespace chunked_list {
 
 // C++ Template class wrapping the C chunked_list
-template <typename T>
+// Compare is the ordering used by the sorted operations (lower_bound, upper_bound, find, insert_sorted)
+template <typename T, typename Compare = std::less<T>>
 class ChunkedList {
 public:
-    // Constructor
-    ChunkedList(size_t chunk_size = CHUNKED_LIST_CHUNK_SIZE) : chunked_list_(nullptr), own_container_(true) {
-        chunked_list_ = chunked_list_create(sizeof(T), chunk_size);
+    using value_type = T;
+
+    // Constructor, flags is 0, CHUNKED_LIST_FLAG_READER_SAFE or CHUNKED_LIST_FLAG_SLOT_MAP
+    ChunkedList(size_t chunk_size = CHUNKED_LIST_CHUNK_SIZE, const Compare& compare = Compare(), unsigned flags = 0)
+        : chunked_list_(nullptr), own_container_(true), compare_(compare) {
+        chunked_list_ = chunked_list_create_ex(sizeof(T), chunk_size, flags);
         if (!chunked_list_) {
             throw std::runtime_error("Failed to create chunked_list.");
         }
     }
 
+    // Constructor for lists with flags, which does not need the ordering spelled out
+    ChunkedList(size_t chunk_size, unsigned flags, const Compare& compare = Compare())
+        : ChunkedList(chunk_size, compare, flags) {}
+
+    // Move constructor, the moved-from list becomes empty and unusable
+    ChunkedList(ChunkedList&& other) noexcept
+        : chunked_list_(other.chunked_list_), own_container_(other.own_container_), compare_(std::move(other.compare_)) {
+        other.chunked_list_ = nullptr;
+    }
+
     // Destructor
     ~ChunkedList() {
         if (own_container_ && chunked_list_) {
@@ -36,15 +69,27 @@ public:
         own_container_ = own_container;  
     }
 
+    // Take a copy-on-write snapshot sharing the chunks of this chunked_list
+    ChunkedList snapshot() {
+        CHUNKED_LIST_HANDLE list = chunked_list_snapshot(chunked_list_);
+        if (!list) {
+            throw std::bad_alloc();
+        }
+        return ChunkedList(list, compare_, adopt_tag());
+    }
+
 	// Emplace a new object in the chunk list using perfect forwarding
     template <typename... Args>
     void emplace(Args&&... args) {
-        void* newItemPtr = nullptr;
+        if (chunked_list_flags(chunked_list_) & CHUNKED_LIST_FLAG_READER_SAFE) {
+            // Reader-safe lists only publish complete items
+            add(T(std::forward<Args>(args)...));
+            return;
+        }
 
         // Expand the chunk list to allocate space for the new item
-        if (chunked_list_expand(chunked_list_, &newItemPtr) != CHUNKED_LIST_SUCCESS) {
-            throw std::bad_alloc();
-        }
+        void* newItemPtr = nullptr;
+        check_result(chunked_list_expand(chunked_list_, &newItemPtr), "emplace is not supported by variable-length lists.");
 
         // Construct the new object in the allocated space using placement new
         new (newItemPtr) T(std::forward<Args>(args)...);
@@ -57,6 +102,112 @@ public:
         }
     }
 
+    // Add an item to a slot-map list and return its stable handle
+    CHUNKED_LIST_SLOT_HANDLE add_slot(const T& item) {
+        CHUNKED_LIST_SLOT_HANDLE handle;
+        int error_code = chunked_list_add_slot(chunked_list_, &item, &handle);
+        if (error_code == CHUNKED_LIST_ERROR_INVALID_OPERATION) {
+            throw std::logic_error("add_slot requires a slot-map list.");
+        }
+        if (error_code != CHUNKED_LIST_SUCCESS) {
+            throw std::bad_alloc();
+        }
+        return handle;
+    }
+
+    // Emplace a new object in a slot-map list and return its stable handle
+    template <typename... Args>
+    CHUNKED_LIST_SLOT_HANDLE emplace_slot(Args&&... args) {
+        void* newItemPtr = nullptr;
+        CHUNKED_LIST_SLOT_HANDLE handle;
+        int error_code = chunked_list_expand_slot(chunked_list_, &newItemPtr, &handle);
+        if (error_code == CHUNKED_LIST_ERROR_INVALID_OPERATION) {
+            throw std::logic_error("emplace_slot requires a slot-map list.");
+        }
+        if (error_code != CHUNKED_LIST_SUCCESS) {
+            throw std::bad_alloc();
+        }
+        new (newItemPtr) T(std::forward<Args>(args)...);
+        return handle;
+    }
+
+    // Get an item of a slot-map list by its handle
+    T& at_slot(CHUNKED_LIST_SLOT_HANDLE handle) {
+        void* item_ptr = nullptr;
+        if (chunked_list_at_slot(chunked_list_, handle, &item_ptr) != CHUNKED_LIST_SUCCESS) {
+            throw std::out_of_range("Invalid slot handle.");
+        }
+        return *reinterpret_cast<T*>(item_ptr);
+    }
+
+    // Check whether a handle of a slot-map list refers to an item
+    bool contains_slot(CHUNKED_LIST_SLOT_HANDLE handle) {
+        void* item_ptr = nullptr;
+        return chunked_list_at_slot(chunked_list_, handle, &item_ptr) == CHUNKED_LIST_SUCCESS;
+    }
+
+    // Remove an item of a slot-map list by its handle, other items do not move
+    void remove_slot(CHUNKED_LIST_SLOT_HANDLE handle) {
+        int error_code = chunked_list_remove_slot(chunked_list_, handle);
+        if (error_code == CHUNKED_LIST_ERROR_ALLOCATION_FAILED) {
+            throw std::bad_alloc();
+        }
+        if (error_code != CHUNKED_LIST_SUCCESS) {
+            throw std::out_of_range("Invalid slot handle.");
+        }
+    }
+
+    // Insert an item at a specific index, shifting the following items
+    void insert(size_t index, const T& item) {
+        void* newItemPtr = nullptr;
+        int error_code = chunked_list_insert(chunked_list_, index, &newItemPtr);
+        if (error_code == CHUNKED_LIST_ERROR_INVALID_INDEX) {
+            throw std::out_of_range("Failed to insert item: Index out of range.");
+        }
+        if (error_code == CHUNKED_LIST_ERROR_INVALID_OPERATION) {
+            throw std::logic_error("insert is not supported by reader-safe and slot-map lists.");
+        }
+        if (error_code != CHUNKED_LIST_SUCCESS) {
+            throw std::bad_alloc();
+        }
+        new (newItemPtr) T(item);
+    }
+
+    // Insert an item behind all equivalent items of the sorted list and return its index
+    size_t insert_sorted(const T& item) {
+        size_t index = upper_bound(item);
+        insert(index, item);
+        return index;
+    }
+
+    // Index of the first item not ordered before value in the sorted list, or size()
+    size_t lower_bound(const T& value) {
+        size_t index = 0;
+        check_result(chunked_list_lower_bound(chunked_list_, &value, &less_callback, &compare_, &index, nullptr),
+                     "lower_bound is not supported by variable-length and slot-map lists.");
+        return index;
+    }
+
+    // Index of the first item value is ordered before in the sorted list, or size()
+    size_t upper_bound(const T& value) {
+        size_t index = 0;
+        check_result(chunked_list_upper_bound(chunked_list_, &value, &less_callback, &compare_, &index, nullptr),
+                     "upper_bound is not supported by variable-length and slot-map lists.");
+        return index;
+    }
+
+    // Index of the first item equivalent to value in the sorted list, or size() if there is none
+    size_t find(const T& value) {
+        size_t index = 0;
+        void* item_ptr = nullptr;
+        check_result(chunked_list_lower_bound(chunked_list_, &value, &less_callback, &compare_, &index, &item_ptr),
+                     "find is not supported by variable-length and slot-map lists.");
+        if (!item_ptr || compare_(value, *reinterpret_cast<T*>(item_ptr))) {
+            return size();
+        }
+        return index;
+    }
+
     // Get an item chunked_list_at a specific index as a reference
     T& at(size_t index) {
         void* item_ptr = nullptr;
@@ -89,6 +240,127 @@ public:
     size_t size() const {
         return chunked_list_count(chunked_list_);  // Use the chunked_list_count function to get the size
     }
+
+    // Pre-allocate chunks so that appending up to n_items items does not allocate memory
+    void reserve(size_t n_items) {
+        check_result(chunked_list_reserve(chunked_list_, n_items), "reserve is not supported by variable-length lists.");
+    }
+
+    // Get the number of items the chunked_list can hold before appending allocates memory
+    size_t capacity() const {
+        return chunked_list_capacity(chunked_list_);
+    }
+
+    // Get the layout statistics and operation counters of the chunked_list
+    CHUNKED_LIST_STATS stats() const {
+        CHUNKED_LIST_STATS result;
+        if (chunked_list_get_stats(chunked_list_, &result) != CHUNKED_LIST_SUCCESS) {
+            throw std::runtime_error("Failed to get chunked_list statistics.");
+        }
+        return result;
+    }
+
+    // Compress the full chunks not accessed during the last min_idle_sweeps calls, returns the number of compressed chunks
+    size_t compress_cold(size_t min_idle_sweeps = 0) {
+        size_t compressed = 0;
+        check_result(chunked_list_compress_cold(chunked_list_, min_idle_sweeps, &compressed),
+                     "compress_cold is not supported by reader-safe and slot-map lists.");
+        return compressed;
+    }
+
+    // Move the chunks into contiguous slabs in list order for faster scans, returns the number of moved chunks
+    size_t relayout() {
+        size_t relocated = 0;
+        if (chunked_list_relayout(chunked_list_, &relocated) != CHUNKED_LIST_SUCCESS) {
+            throw std::bad_alloc();
+        }
+        return relocated;
+    }
+
+    // Set the NUMA placement of new chunks, CHUNKED_LIST_NUMA_LOCAL, _INTERLEAVE or _BIND to node
+    void set_numa_policy(int policy, int node = 0) {
+        int error_code = chunked_list_set_numa_policy(chunked_list_, policy, node);
+        if (error_code == CHUNKED_LIST_ERROR_INVALID_INDEX) {
+            throw std::out_of_range("Failed to set NUMA policy: Node out of range.");
+        }
+        if (error_code != CHUNKED_LIST_SUCCESS) {
+            throw std::invalid_argument("Failed to set NUMA policy: Unknown policy.");
+        }
+    }
+
+    // Call func(item, index) for every item from workers on the node of its chunk, func must be thread-safe
+    template <typename Func>
+    void scan_parallel(size_t workers_per_node, Func&& func) {
+        check_result(chunked_list_scan_parallel(chunked_list_, workers_per_node, &scan_callback<Func>, (void*)&func),
+                     "scan_parallel is not supported by variable-length lists.");
+    }
+
+    // Free the retired chunks of a reader-safe list no reader may hold anymore, returns the number still retired
+    size_t reclaim() {
+        return chunked_list_reclaim(chunked_list_);
+    }
+
+    // A reader thread of a reader-safe list, registered for its lifetime
+    class reader {
+    public:
+        explicit reader(ChunkedList& list)
+            : handle_(chunked_list_reader_register(list.chunked_list_)) {
+            if (!handle_) {
+                throw std::runtime_error("Failed to register reader: the list is not reader-safe or memory allocation failed.");
+            }
+        }
+
+        ~reader() {
+            chunked_list_reader_unregister(handle_);
+        }
+
+        reader(const reader&) = delete;
+        reader& operator=(const reader&) = delete;
+
+        // Start a read section, chunks reachable from now on are not freed until exit()
+        void enter() {
+            chunked_list_reader_enter(handle_);
+        }
+
+        // End the read section, items and iterators obtained in it must not be used anymore
+        void exit() {
+            chunked_list_reader_exit(handle_);
+        }
+
+    private:
+        CHUNKED_LIST_READER_HANDLE handle_; // The C reader handle
+    };
+
+    // A read section of a reader for the lifetime of the guard
+    class read_guard {
+    public:
+        explicit read_guard(reader& r) : reader_(r) {
+            reader_.enter();
+        }
+
+        ~read_guard() {
+            reader_.exit();
+        }
+
+        read_guard(const read_guard&) = delete;
+        read_guard& operator=(const read_guard&) = delete;
+
+    private:
+        reader& reader_;
+    };
+
+    // Enable per-chunk key summaries used by scan_range (nullptr disables them)
+    void set_key_extractor(CHUNKED_LIST_KEY_EXTRACTOR extractor) {
+        check_result(chunked_list_set_key_extractor(chunked_list_, extractor),
+                     "set_key_extractor is not supported by variable-length and slot-map lists.");
+    }
+
+    // Call func(item, index) for every item with a key in [min_key, max_key], skipping non-matching chunks
+    template <typename Func>
+    void scan_range(int64_t min_key, int64_t max_key, Func&& func) {
+        check_result(chunked_list_scan_range(chunked_list_, min_key, max_key, &scan_callback<Func>, (void*)&func),
+                     "scan_range requires a key extractor.");
+    }
 	
 class iterator {
 	public:
@@ -101,7 +373,7 @@ class iterator {
 
     // Constructor: Takes a handle to a chunked list and initializes the iterator
     // or create an end iterator if the handle is null
-    iterator(ChunkedList<T>* list)
+    iterator(ChunkedList* list)
         : currentItem(nullptr) 
     {
         if (list) {
@@ -146,6 +418,14 @@ class iterator {
         return chunked_list_iterator_get_index(c_iterator);
     }
 
+    // Handle of the current item of a slot-map list
+    CHUNKED_LIST_SLOT_HANDLE slot() const {
+        CHUNKED_LIST_SLOT_HANDLE handle;
+        if (chunked_list_iterator_get_slot(c_iterator, &handle) != CHUNKED_LIST_ITERATOR_SUCCESS)
+            throw std::out_of_range("Failed to get slot handle.");
+        return handle;
+    }
+
 	//// Post-increment operator
 	//iterator operator++(int) {
 	//	iterator tmp = *this;
@@ -182,8 +462,223 @@ private:
     }
 	
 private:
+    struct adopt_tag {};
+
+    // Take ownership of an existing C-style chunked_list
+    ChunkedList(CHUNKED_LIST_HANDLE list, const Compare& compare, adopt_tag)
+        : chunked_list_(list), own_container_(true), compare_(compare) {
+    }
+
+    // Adapter forwarding C scan callbacks to a C++ callable
+    template <typename Func>
+    static int scan_callback(void* item, size_t index, void* context) {
+        (*reinterpret_cast<typename std::remove_reference<Func>::type*>(context))(*reinterpret_cast<T*>(item), index);
+        return 0;
+    }
+
+    // Translate the result of a C function: logic_error if the list mode does not support it, bad_alloc if memory ran out,
+    // out_of_range for an invalid index
+    static void check_result(int error_code, const char* unsupported_message) {
+        if (error_code == CHUNKED_LIST_ERROR_INVALID_OPERATION) {
+            throw std::logic_error(unsupported_message);
+        }
+        if (error_code == CHUNKED_LIST_ERROR_ALLOCATION_FAILED) {
+            throw std::bad_alloc();
+        }
+        if (error_code == CHUNKED_LIST_ERROR_INVALID_INDEX) {
+            throw std::out_of_range("Index out of range.");
+        }
+        if (error_code != CHUNKED_LIST_SUCCESS) {
+            throw std::runtime_error("Unexpected chunked_list error.");
+        }
+    }
+
+    // Adapter forwarding C ordering callbacks to Compare
+    static int less_callback(const void* lhs, const void* rhs, void* context) {
+        return (*reinterpret_cast<Compare*>(context))(*reinterpret_cast<const T*>(lhs), *reinterpret_cast<const T*>(rhs)) ? 1 : 0;
+    }
+
     CHUNKED_LIST_HANDLE chunked_list_;       // The handle to the C-style chunked_list
     bool own_container_;     // Flag to indicate ownership of the chunked_list
+    Compare compare_;        // Ordering used by the sorted operations
+};
+
+// C++ class wrapping a variable-length chunked_list, items are byte strings viewed as std::string_view
+class ChunkedByteList {
+public:
+    using value_type = std::string_view;
+
+    // Constructor
+    ChunkedByteList(size_t chunk_size = CHUNKED_LIST_CHUNK_SIZE)
+        : chunked_list_(chunked_list_create_ex(0, chunk_size, CHUNKED_LIST_FLAG_VARIABLE_LENGTH)) {
+        if (!chunked_list_) {
+            throw std::runtime_error("Failed to create chunked_list.");
+        }
+    }
+
+    // Move constructor, the moved-from list becomes empty and unusable
+    ChunkedByteList(ChunkedByteList&& other) noexcept : chunked_list_(other.chunked_list_) {
+        other.chunked_list_ = nullptr;
+    }
+
+    // Destructor
+    ~ChunkedByteList() {
+        if (chunked_list_) {
+            chunked_list_destroy(chunked_list_);
+        }
+    }
+
+    // Take a copy-on-write snapshot sharing the chunks of this chunked_list
+    ChunkedByteList snapshot() {
+        CHUNKED_LIST_HANDLE list = chunked_list_snapshot(chunked_list_);
+        if (!list) {
+            throw std::bad_alloc();
+        }
+        return ChunkedByteList(list);
+    }
+
+    // Add a copy of length bytes at data to the chunked_list
+    void add(const void* data, size_t length) {
+        int error_code = chunked_list_add_bytes(chunked_list_, data, length);
+        if (error_code == CHUNKED_LIST_ERROR_INVALID_OPERATION) {
+            throw std::length_error("Failed to add item: Item too large.");
+        }
+        if (error_code != CHUNKED_LIST_SUCCESS) {
+            throw std::bad_alloc();
+        }
+    }
+
+    // Add a copy of a string to the chunked_list
+    void add(std::string_view item) {
+        add(item.data(), item.size());
+    }
+
+    // Get a view of the item at a specific index, valid until the item is removed
+    std::string_view at(size_t index) const {
+        void* item_ptr = nullptr;
+        size_t length = 0;
+        if (chunked_list_at_bytes(chunked_list_, index, &item_ptr, &length) != CHUNKED_LIST_SUCCESS) {
+            throw std::out_of_range("Index out of range.");
+        }
+        return std::string_view(reinterpret_cast<const char*>(item_ptr), length);
+    }
+
+    // Operator[] to access items by index
+    std::string_view operator[](size_t index) const {
+        return at(index);
+    }
+
+#ifdef __cpp_lib_span
+    // Get the raw bytes of the item at a specific index
+    std::span<const std::byte> bytes(size_t index) const {
+        std::string_view item = at(index);
+        return std::span<const std::byte>(reinterpret_cast<const std::byte*>(item.data()), item.size());
+    }
+#endif
+
+    // Remove an item at a specific index
+    void remove(size_t index) {
+        if (chunked_list_remove(chunked_list_, index) != CHUNKED_LIST_SUCCESS) {
+            throw std::out_of_range("Failed to remove item: Index out of range.");
+        }
+    }
+
+    // Clear the chunked_list
+    void clear() {
+        if (chunked_list_clear(chunked_list_) != CHUNKED_LIST_SUCCESS) {
+            throw std::runtime_error("Failed to clear chunked_list.");
+        }
+    }
+
+    // Get the size of the chunked_list (number of items)
+    size_t size() const {
+        return chunked_list_count(chunked_list_);
+    }
+
+    // Get the layout statistics and operation counters of the chunked_list
+    CHUNKED_LIST_STATS stats() const {
+        CHUNKED_LIST_STATS result;
+        if (chunked_list_get_stats(chunked_list_, &result) != CHUNKED_LIST_SUCCESS) {
+            throw std::runtime_error("Failed to get chunked_list statistics.");
+        }
+        return result;
+    }
+
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string_view*;
+        using reference = std::string_view;
+
+        // Constructor, creates an end iterator if the list is null
+        iterator(const ChunkedByteList* list) : c_iterator(nullptr) {
+            if (list) {
+                c_iterator = chunked_list_iterator_create(list->chunked_list_);
+                if (c_iterator == nullptr)
+                    throw std::bad_alloc();
+            }
+        }
+
+        // Destructor: Cleans up the C iterator
+        ~iterator() {
+            chunked_list_iterator_destroy(c_iterator);
+        }
+
+        // Dereference operator returning a view of the current item
+        std::string_view operator*() const {
+            void* item_ptr = nullptr;
+            size_t length = 0;
+            if (chunked_list_iterator_get_bytes(c_iterator, &item_ptr, &length) != CHUNKED_LIST_ITERATOR_SUCCESS)
+                throw std::out_of_range("Failed to get item: Index out of range.");
+            return std::string_view(reinterpret_cast<const char*>(item_ptr), length);
+        }
+
+        // Prefix increment to move to the next item
+        iterator& operator++() {
+            if (chunked_list_iterator_next(c_iterator) != CHUNKED_LIST_ITERATOR_SUCCESS)
+                throw std::out_of_range("Failed to move iterator: Index out of range.");
+            return *this;
+        }
+
+        size_t index() const {
+            return chunked_list_iterator_get_index(c_iterator);
+        }
+
+        // Equality comparison
+        bool operator==(const iterator& other) const {
+            if (other.c_iterator)
+                return index() == other.index();
+            else // other is an end iterator
+                return chunked_list_iterator_is_end(c_iterator) == 1;
+        }
+
+        // Inequality comparison
+        bool operator!=(const iterator& other) const {
+            return !operator==(other);
+        }
+
+    private:
+        CHUNKED_LIST_ITERATOR_HANDLE c_iterator; // The C iterator handle
+    };
+
+    // Return iterator pointing to the first element
+    iterator begin() const {
+        return iterator(this);
+    }
+
+    // Return iterator pointing to one past the last element
+    iterator end() const {
+        return iterator(nullptr);
+    }
+
+private:
+    // Take ownership of an existing C-style chunked_list
+    explicit ChunkedByteList(CHUNKED_LIST_HANDLE list) : chunked_list_(list) {
+    }
+
+    CHUNKED_LIST_HANDLE chunked_list_;       // The handle to the C-style chunked_list
 };
 
 	}
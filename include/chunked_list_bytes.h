@@ -0,0 +1,53 @@
+#ifndef CHUNKED_LIST_BYTES_H
+#define CHUNKED_LIST_BYTES_H
+
+#include "chunked_list.h"
+#include "chunked_list_iterator.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Appends a variable-length item to the end of the chunked list.
+ *
+ * The list must be created by chunked_list_create_ex with CHUNKED_LIST_FLAG_VARIABLE_LENGTH.
+ * Items are packed back to back from the start of a chunk, while a table of 32-bit offsets
+ * grows from its end, so a chunk holds as many items as fit in chunk_size bytes including
+ * 4 bytes of overhead per item. An item larger than a chunk gets a dedicated chunk of its own size.
+ *
+ * @param list A handle to the chunked list.
+ * @param item A pointer to the bytes of the item.
+ * @param length The length of the item in bytes, may be 0.
+ * @return CHUNKED_LIST_SUCCESS on success, CHUNKED_LIST_ERROR_ALLOCATION_FAILED if memory allocation fails,
+ *         or CHUNKED_LIST_ERROR_INVALID_OPERATION if the list is not in variable-length mode or length exceeds 4 GB.
+ */
+int chunked_list_add_bytes(CHUNKED_LIST_HANDLE list, const void* item, size_t length);
+
+/**
+ * @brief Retrieves a variable-length item at a specific index in the chunked list.
+ *
+ * @param list A handle to the chunked list.
+ * @param index The index of the item to retrieve.
+ * @param item Pointer where the address of the item will be stored.
+ * @param length Pointer where the length of the item will be stored, may be NULL.
+ * @return CHUNKED_LIST_SUCCESS on success, CHUNKED_LIST_ERROR_INVALID_INDEX if the index is invalid,
+ *         or CHUNKED_LIST_ERROR_INVALID_OPERATION if the list is not in variable-length mode.
+ */
+int chunked_list_at_bytes(CHUNKED_LIST_HANDLE list, size_t index, void** item, size_t* length);
+
+/**
+ * Get the current variable-length item in the iterator.
+ * @param iterator The iterator handle.
+ * @param item A pointer to store the current item.
+ * @param length A pointer to store the length of the current item, may be NULL.
+ * @return CHUNKED_LIST_ITERATOR_SUCCESS if successful, CHUNKED_LIST_ITERATOR_ERROR_INVALID_INDEX if the iterator
+ *         is out of bounds, or CHUNKED_LIST_ITERATOR_ERROR_INVALID_OPERATION if the list is not in variable-length mode.
+ */
+int chunked_list_iterator_get_bytes(CHUNKED_LIST_ITERATOR_HANDLE iterator, void** item, size_t* length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHUNKED_LIST_BYTES_H
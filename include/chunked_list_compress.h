@@ -0,0 +1,41 @@
+#ifndef CHUNKED_LIST_COMPRESS_H
+#define CHUNKED_LIST_COMPRESS_H
+
+#include "chunked_list.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Compresses the full chunks that were not accessed recently.
+ *
+ * Every call is a sweep advancing a logical clock of the list, and every chunk remembers the
+ * sweep in which its items were last read or written (chunked_list_at, chunked_list_expand,
+ * chunked_list_insert, chunked_list_remove, the iterator, sorted lookups and range scans).
+ * Calling this function periodically, e.g. once a minute, compresses chunks that stayed
+ * untouched for min_idle_sweeps periods; 0 compresses all full chunks right away.
+ *
+ * The items of a chunk are encoded word by word as the difference to the same word of the
+ * previous item (zigzag varints, runs of zero differences collapsed), which suits counters,
+ * timestamps and repeated fields. A chunk is only replaced by its compressed copy if that
+ * saves at least a quarter of its size. Compressed chunks are decompressed transparently
+ * the next time their items are accessed; sorted lookups only decompress the chunk they
+ * end up searching.
+ *
+ * Chunks shared with snapshots are left alone. Pointers to items of compressed chunks are
+ * invalidated, like by chunked_list_remove, so iterators must not be held across a sweep.
+ *
+ * @param list A handle to the chunked list.
+ * @param min_idle_sweeps Number of sweeps a chunk must have stayed unaccessed.
+ * @param compressed_chunks Pointer where the number of chunks compressed by this sweep will be stored, may be NULL.
+ * @return CHUNKED_LIST_SUCCESS on success, CHUNKED_LIST_ERROR_ALLOCATION_FAILED if memory allocation fails,
+ *         or CHUNKED_LIST_ERROR_INVALID_OPERATION in variable-length, reader-safe and slot-map mode.
+ */
+int chunked_list_compress_cold(CHUNKED_LIST_HANDLE list, size_t min_idle_sweeps, size_t* compressed_chunks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHUNKED_LIST_COMPRESS_H
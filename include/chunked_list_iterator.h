@@ -15,6 +15,12 @@ typedef void* CHUNKED_LIST_ITERATOR_HANDLE;
 /// Error code for invalid index
 #define CHUNKED_LIST_ITERATOR_ERROR_INVALID_INDEX -1
 
+/// Error code for failed memory allocation
+#define CHUNKED_LIST_ITERATOR_ERROR_ALLOCATION_FAILED -2
+
+/// Error code for an operation not supported by the mode of the list
+#define CHUNKED_LIST_ITERATOR_ERROR_INVALID_OPERATION -3
+
 /**
  * Create an iterator for the chunked list.
  * @param list The chunked list to iterate over.
@@ -39,7 +45,9 @@ int chunked_list_iterator_get(CHUNKED_LIST_ITERATOR_HANDLE iterator, void** item
 /**
  * Move to the next item in the iterator.
  * @param iterator The iterator handle.
- * @return 0 if successful, -1 if the iterator has reached the end.
+ * @return CHUNKED_LIST_ITERATOR_SUCCESS if successful, CHUNKED_LIST_ITERATOR_ERROR_INVALID_INDEX if the
+ *         iterator has reached the end, or CHUNKED_LIST_ITERATOR_ERROR_ALLOCATION_FAILED if the next
+ *         chunk is compressed and decompressing it fails.
  */
 int chunked_list_iterator_next(CHUNKED_LIST_ITERATOR_HANDLE iterator);
 
@@ -0,0 +1,37 @@
+#ifndef CHUNKED_LIST_LAYOUT_H
+#define CHUNKED_LIST_LAYOUT_H
+
+#include "chunked_list.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Moves the chunks of the list into contiguous slabs, in list order.
+ *
+ * Chunks allocated one by one end up wherever the allocator placed them, so a scan jumps
+ * between unrelated addresses at every chunk boundary. This function copies the chunks into
+ * as few slabs as possible, with ascending addresses along the chain, so that the hardware
+ * prefetcher can stream the whole list. Consecutive chunks on the same NUMA node share a slab
+ * on that node; a list whose chunks are interleaved across nodes keeps its placement.
+ * Empty chunks left behind by removals are dropped. Compressed chunks, chunks shared with
+ * snapshots and the oversized chunks of variable-length items larger than a chunk are left
+ * in place, and the spare chunks of the list are not touched.
+ *
+ * Pointers to items and iterators are invalidated, like by chunked_list_remove; handles of a
+ * slot-map list stay valid. Concurrent readers of a reader-safe list may keep reading, the
+ * old chunks are retired until they left their read sections. The list is left unchanged if
+ * memory allocation fails.
+ *
+ * @param list A handle to the chunked list.
+ * @param relocated_chunks Pointer where the number of moved chunks will be stored, may be NULL.
+ * @return CHUNKED_LIST_SUCCESS on success, or CHUNKED_LIST_ERROR_ALLOCATION_FAILED if memory allocation fails.
+ */
+int chunked_list_relayout(CHUNKED_LIST_HANDLE list, size_t* relocated_chunks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHUNKED_LIST_LAYOUT_H
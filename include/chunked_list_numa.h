@@ -0,0 +1,97 @@
+#ifndef CHUNKED_LIST_NUMA_H
+#define CHUNKED_LIST_NUMA_H
+
+#include "chunked_list.h"
+#include "chunked_list_scan.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Chunks are allocated on the node of the appending thread (default)
+#define CHUNKED_LIST_NUMA_LOCAL 0
+
+/// Chunks are spread round-robin over all nodes
+#define CHUNKED_LIST_NUMA_INTERLEAVE 1
+
+/// Chunks are allocated on a given node
+#define CHUNKED_LIST_NUMA_BIND 2
+
+/*
+ * Chunks are placed on NUMA nodes in units of at least one page: a chunk of 16 KiB is a unit of
+ * its own, smaller chunks are carved in groups from page-aligned slabs. Every chunk records the
+ * node holding its items. Appends do not map memory for every chunk: they take chunks from
+ * batches of one slab per node, which double in size up to 1 MiB per node. Real placement requires building with CHUNKED_LIST_ENABLE_NUMA
+ * (make NUMA=1), which links libnuma; without it, or after chunked_list_numa_simulate, the
+ * policies only decide which node is recorded for each chunk, so the whole API can be
+ * exercised on a single-node machine.
+ */
+
+/**
+ * @brief Simulates a machine with node_count NUMA nodes, or restores the real topology.
+ *
+ * Affects chunks allocated and scans started afterwards. Not thread-safe, meant to be called
+ * once at startup, e.g. by tests.
+ *
+ * @param node_count The number of simulated nodes, 0 for the real topology.
+ */
+void chunked_list_numa_simulate(int node_count);
+
+/**
+ * @brief Gets the number of NUMA nodes, 1 if NUMA is not supported.
+ *
+ * @return The number of real or simulated nodes.
+ */
+int chunked_list_numa_node_count(void);
+
+/**
+ * @brief Sets the placement policy for the chunks allocated from now on.
+ *
+ * Applies to appended chunks, chunks reserved by chunked_list_reserve and copies of shared
+ * or compressed chunks. Chunks holding items stay where they are, spare chunks reserved
+ * before are released.
+ *
+ * @param list A handle to the chunked list.
+ * @param policy CHUNKED_LIST_NUMA_LOCAL, CHUNKED_LIST_NUMA_INTERLEAVE or CHUNKED_LIST_NUMA_BIND.
+ * @param node The node for CHUNKED_LIST_NUMA_BIND, ignored otherwise.
+ * @return CHUNKED_LIST_SUCCESS on success, CHUNKED_LIST_ERROR_INVALID_INDEX if node does not exist,
+ *         or CHUNKED_LIST_ERROR_INVALID_OPERATION if policy is unknown.
+ */
+int chunked_list_set_numa_policy(CHUNKED_LIST_HANDLE list, int policy, int node);
+
+/**
+ * @brief Counts the chunks of the list holding items on each node.
+ *
+ * @param list A handle to the chunked list.
+ * @param chunk_counts Array receiving the number of chunks per node.
+ * @param node_count Number of entries in chunk_counts, nodes beyond it are not counted.
+ * @return The total number of chunks holding items.
+ */
+size_t chunked_list_numa_chunks(CHUNKED_LIST_HANDLE list, size_t* chunk_counts, size_t node_count);
+
+/**
+ * @brief Visits all items with worker threads running on the node of the visited chunk.
+ *
+ * Starts workers_per_node threads for every node holding chunks of the list; each of them
+ * is bound to its node and visits whole chunks of that node, so items are read from local
+ * memory. The callback is invoked concurrently from the workers and items are not visited
+ * in list order, but the index passed to it is the position of the item in the list.
+ * A non-zero return value of the callback stops all workers after their current item.
+ * Compressed chunks are decompressed before the workers start. The list must not be
+ * modified during the scan.
+ *
+ * @param list A handle to the chunked list.
+ * @param workers_per_node The number of worker threads per node, at least 1.
+ * @param callback The callback invoked for each item.
+ * @param context User pointer passed through to the callback.
+ * @return CHUNKED_LIST_SUCCESS on success, CHUNKED_LIST_ERROR_INVALID_OPERATION in variable-length mode,
+ *         or CHUNKED_LIST_ERROR_ALLOCATION_FAILED if memory allocation fails.
+ */
+int chunked_list_scan_parallel(CHUNKED_LIST_HANDLE list, size_t workers_per_node,
+                               CHUNKED_LIST_SCAN_CALLBACK callback, void* context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHUNKED_LIST_NUMA_H
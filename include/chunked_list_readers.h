@@ -0,0 +1,81 @@
+#ifndef CHUNKED_LIST_READERS_H
+#define CHUNKED_LIST_READERS_H
+
+#include "chunked_list.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Opaque type for the handle of a reader registered with a reader-safe list
+typedef void* CHUNKED_LIST_READER_HANDLE;
+
+/*
+ * A list created with CHUNKED_LIST_FLAG_READER_SAFE may be read by any number of threads while
+ * one writer thread modifies it, without locks:
+ *
+ * - The writer publishes appended items and chunks with release stores after writing them, so
+ *   chunked_list_expand and chunked_list_insert, which return the address of an unwritten item,
+ *   are rejected; use chunked_list_add.
+ * - chunked_list_remove never shifts items in place, it publishes a copy of the chunk without
+ *   the item and retires the old chunk.
+ * - Retired chunks are freed by the writer once every reader that could have seen them has left
+ *   its read section (epoch-based reclamation).
+ *
+ * Readers call chunked_list_at, chunked_list_count and the iterator functions between
+ * chunked_list_reader_enter and chunked_list_reader_exit. A reader only writes its own slot,
+ * aligned to a cache line, and never blocks. It sees every item added before it entered and
+ * may or may not see concurrent changes; indexes may shift under it due to concurrent removals.
+ * All other functions, including range scans, sorted lookups, snapshots and statistics, are
+ * reserved to the writer thread. The operation counters of CHUNKED_LIST_ENABLE_STATS do not
+ * count the chunked_list_at calls of a reader-safe list, since counting them would be a write.
+ */
+
+/**
+ * @brief Registers a reader of a reader-safe list.
+ *
+ * Usually called once per reader thread. May be called from any thread, concurrently with
+ * the writer and other readers.
+ *
+ * @param list A handle to a chunked list created with CHUNKED_LIST_FLAG_READER_SAFE.
+ * @return A handle to the reader, or NULL if memory allocation fails or the list is not reader-safe.
+ */
+CHUNKED_LIST_READER_HANDLE chunked_list_reader_register(CHUNKED_LIST_HANDLE list);
+
+/**
+ * @brief Unregisters a reader, its slot is reused by the next registration.
+ *
+ * @param reader A reader handle outside of its read section.
+ */
+void chunked_list_reader_unregister(CHUNKED_LIST_READER_HANDLE reader);
+
+/**
+ * @brief Starts a read section, chunks reachable from now on are not freed until it ends.
+ *
+ * @param reader The reader handle.
+ */
+void chunked_list_reader_enter(CHUNKED_LIST_READER_HANDLE reader);
+
+/**
+ * @brief Ends a read section, items and iterators obtained in it must not be used anymore.
+ *
+ * @param reader The reader handle.
+ */
+void chunked_list_reader_exit(CHUNKED_LIST_READER_HANDLE reader);
+
+/**
+ * @brief Frees the retired chunks no reader may hold anymore.
+ *
+ * The writer reclaims chunks automatically after every operation retiring chunks, this function lets it
+ * release memory after readers left without further modifications. Writer thread only.
+ *
+ * @param list A handle to the chunked list.
+ * @return The number of retired chunks still waiting for readers.
+ */
+size_t chunked_list_reclaim(CHUNKED_LIST_HANDLE list);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHUNKED_LIST_READERS_H
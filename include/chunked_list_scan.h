@@ -0,0 +1,54 @@
+#ifndef CHUNKED_LIST_SCAN_H
+#define CHUNKED_LIST_SCAN_H
+
+#include <stdint.h>
+#include "chunked_list.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Callback extracting the ordering key (e.g. a timestamp) from an item
+typedef int64_t (*CHUNKED_LIST_KEY_EXTRACTOR)(const void* item);
+
+/// Callback invoked for every matching item; return 0 to continue, non-zero to stop the scan
+typedef int (*CHUNKED_LIST_SCAN_CALLBACK)(void* item, size_t index, void* context);
+
+/**
+ * @brief Enables per-chunk key summaries (zone maps).
+ *
+ * Every chunk keeps the minimum and maximum key of its items, so range scans can skip
+ * whole chunks without reading their payload. Summaries are maintained by chunked_list_add
+ * and chunked_list_remove; items created by chunked_list_expand are folded in lazily by
+ * the next chunked_list_add or chunked_list_scan_range. Call this function again after
+ * modifying keys of stored items in place to recompute all summaries.
+ *
+ * @param list A handle to the chunked list.
+ * @param extractor The key callback, or NULL to disable the summaries.
+ * @return CHUNKED_LIST_SUCCESS on success, CHUNKED_LIST_ERROR_INVALID_OPERATION in variable-length and slot-map mode,
+ *         or CHUNKED_LIST_ERROR_ALLOCATION_FAILED if a compressed chunk cannot be decompressed.
+ */
+int chunked_list_set_key_extractor(CHUNKED_LIST_HANDLE list, CHUNKED_LIST_KEY_EXTRACTOR extractor);
+
+/**
+ * @brief Visits all items whose key lies in the inclusive range [min_key, max_key].
+ *
+ * Chunks whose summary does not overlap the range are skipped without touching their items.
+ * Items are visited in list order.
+ *
+ * @param list A handle to the chunked list.
+ * @param min_key The smallest key to visit.
+ * @param max_key The largest key to visit.
+ * @param callback The callback invoked for each matching item.
+ * @param context User pointer passed through to the callback.
+ * @return CHUNKED_LIST_SUCCESS on success, CHUNKED_LIST_ERROR_INVALID_OPERATION if no key extractor is set,
+ *         or CHUNKED_LIST_ERROR_ALLOCATION_FAILED if a compressed chunk cannot be decompressed.
+ */
+int chunked_list_scan_range(CHUNKED_LIST_HANDLE list, int64_t min_key, int64_t max_key,
+                            CHUNKED_LIST_SCAN_CALLBACK callback, void* context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHUNKED_LIST_SCAN_H
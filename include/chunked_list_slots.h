@@ -0,0 +1,92 @@
+#ifndef CHUNKED_LIST_SLOTS_H
+#define CHUNKED_LIST_SLOTS_H
+
+#include <stdint.h>
+#include "chunked_list.h"
+#include "chunked_list_iterator.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Stable handle of an item of a slot-map list, valid until the item is removed
+typedef uint64_t CHUNKED_LIST_SLOT_HANDLE;
+
+/// Handle that never refers to an item
+#define CHUNKED_LIST_INVALID_SLOT_HANDLE ((CHUNKED_LIST_SLOT_HANDLE)0)
+
+/*
+ * In a list created with CHUNKED_LIST_FLAG_SLOT_MAP items never move. Removing an item leaves
+ * a free slot behind, marked in the occupancy bitmap of its chunk, and advances the generation
+ * counter of the slot; free slots are reused by the next chunked_list_add or chunked_list_expand
+ * before the list grows. Items are therefore not kept in the order they were added.
+ *
+ * A handle combines the number of a slot with its generation, so the handle of a removed item
+ * stays invalid after its slot was reused, and looking an item up by handle takes constant time.
+ * Pointers to items stay valid until the item is removed or the list is relaid out.
+ *
+ * Positions (chunked_list_at, chunked_list_remove and the iterator index) count the items in
+ * slot order and change with additions and removals. chunked_list_insert, sorted lookups, key
+ * summaries, snapshots and compression are not available in this mode. Chunks are only freed
+ * by chunked_list_clear, which invalidates all handles.
+ */
+
+/**
+ * @brief Adds an item to a slot-map list and returns its handle.
+ *
+ * @param list A handle to a chunked list created with CHUNKED_LIST_FLAG_SLOT_MAP.
+ * @param item A pointer to the item to be added.
+ * @param handle Pointer where the handle of the new item will be stored, may be NULL.
+ * @return CHUNKED_LIST_SUCCESS on success, CHUNKED_LIST_ERROR_ALLOCATION_FAILED if memory allocation fails,
+ *         or CHUNKED_LIST_ITERATOR_ERROR_INVALID_OPERATION if the list is not a slot map.
+ */
+int chunked_list_add_slot(CHUNKED_LIST_HANDLE list, const void* item, CHUNKED_LIST_SLOT_HANDLE* handle);
+
+/**
+ * @brief Makes room for a new item of a slot-map list and returns its address and handle.
+ *
+ * @param list A handle to a chunked list created with CHUNKED_LIST_FLAG_SLOT_MAP.
+ * @param pnewItem Pointer to a pointer where the address of the new item will be stored.
+ * @param handle Pointer where the handle of the new item will be stored, may be NULL.
+ * @return CHUNKED_LIST_SUCCESS on success, CHUNKED_LIST_ERROR_ALLOCATION_FAILED if memory allocation fails,
+ *         or CHUNKED_LIST_ITERATOR_ERROR_INVALID_OPERATION if the list is not a slot map.
+ */
+int chunked_list_expand_slot(CHUNKED_LIST_HANDLE list, void** pnewItem, CHUNKED_LIST_SLOT_HANDLE* handle);
+
+/**
+ * @brief Retrieves an item by its handle in constant time.
+ *
+ * @param list A handle to a slot-map list.
+ * @param handle The handle of the item.
+ * @param item Pointer to a pointer where the address of the item will be stored.
+ * @return CHUNKED_LIST_SUCCESS on success, CHUNKED_LIST_ERROR_INVALID_INDEX if the item was removed or
+ *         the handle does not belong to the list, or CHUNKED_LIST_ERROR_INVALID_OPERATION if the list is not a slot map.
+ */
+int chunked_list_at_slot(CHUNKED_LIST_HANDLE list, CHUNKED_LIST_SLOT_HANDLE handle, void** item);
+
+/**
+ * @brief Removes an item by its handle in constant time, other items do not move.
+ *
+ * @param list A handle to a slot-map list.
+ * @param handle The handle of the item.
+ * @return CHUNKED_LIST_SUCCESS on success, CHUNKED_LIST_ERROR_INVALID_INDEX if the item was already removed,
+ *         CHUNKED_LIST_ERROR_ALLOCATION_FAILED if the free list cannot grow,
+ *         or CHUNKED_LIST_ITERATOR_ERROR_INVALID_OPERATION if the list is not a slot map.
+ */
+int chunked_list_remove_slot(CHUNKED_LIST_HANDLE list, CHUNKED_LIST_SLOT_HANDLE handle);
+
+/**
+ * @brief Gets the handle of the current item of an iterator over a slot-map list.
+ *
+ * @param iterator The iterator handle.
+ * @param handle Pointer where the handle of the current item will be stored.
+ * @return CHUNKED_LIST_ITERATOR_SUCCESS on success, CHUNKED_LIST_ITERATOR_ERROR_INVALID_INDEX at the end,
+ *         or CHUNKED_LIST_ITERATOR_ERROR_INVALID_OPERATION if the list is not a slot map.
+ */
+int chunked_list_iterator_get_slot(CHUNKED_LIST_ITERATOR_HANDLE iterator, CHUNKED_LIST_SLOT_HANDLE* handle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHUNKED_LIST_SLOTS_H
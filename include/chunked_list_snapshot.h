@@ -0,0 +1,33 @@
+#ifndef CHUNKED_LIST_SNAPSHOT_H
+#define CHUNKED_LIST_SNAPSHOT_H
+
+#include "chunked_list.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Creates a copy-on-write snapshot of a chunked list.
+ *
+ * The snapshot is an independent chunked list sharing the items of the original one through
+ * reference counted chunks, so taking it costs one small header per chunk instead of copying
+ * the items. A chunk is copied only when a list sharing it next shifts its items
+ * (chunked_list_remove, chunked_list_insert) or, for the snapshot, appends to it. Appending to
+ * the original list never copies, since snapshots do not see items added after they were taken.
+ *
+ * The snapshot may be read and destroyed on another thread while the original list is
+ * modified. Items must not be modified in place through pointers returned by chunked_list_at
+ * or the iterator while they are shared, as the change would be visible in both lists.
+ *
+ * @param list A handle to the chunked list.
+ * @return A handle to the snapshot, to be freed with chunked_list_destroy, or NULL if memory allocation fails
+ *         or the list is a slot map.
+ */
+CHUNKED_LIST_HANDLE chunked_list_snapshot(CHUNKED_LIST_HANDLE list);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHUNKED_LIST_SNAPSHOT_H
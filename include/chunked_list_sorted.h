@@ -0,0 +1,52 @@
+#ifndef CHUNKED_LIST_SORTED_H
+#define CHUNKED_LIST_SORTED_H
+
+#include "chunked_list.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Strict weak ordering of two items; returns non-zero if lhs is ordered before rhs
+typedef int (*CHUNKED_LIST_LESS)(const void* lhs, const void* rhs, void* context);
+
+/**
+ * @brief Finds the first item that is not ordered before key.
+ *
+ * The list must be sorted by less. The search is a binary search over the first items of
+ * the chunks, followed by a binary search inside the selected chunk.
+ *
+ * @param list A handle to the chunked list.
+ * @param key A pointer to an item holding the searched key.
+ * @param less The ordering of the list.
+ * @param context User pointer passed through to less.
+ * @param index Pointer where the index of the found item (or the item count) will be stored.
+ * @param item Pointer where the address of the found item (or NULL) will be stored, may be NULL.
+ * @return CHUNKED_LIST_SUCCESS on success, CHUNKED_LIST_ERROR_ALLOCATION_FAILED if memory allocation fails,
+ *         or CHUNKED_LIST_ERROR_INVALID_OPERATION in variable-length and slot-map mode.
+ */
+int chunked_list_lower_bound(CHUNKED_LIST_HANDLE list, const void* key, CHUNKED_LIST_LESS less, void* context,
+                             size_t* index, void** item);
+
+/**
+ * @brief Finds the first item that key is ordered before.
+ *
+ * Same as chunked_list_lower_bound, but skips items equivalent to key.
+ *
+ * @param list A handle to the chunked list.
+ * @param key A pointer to an item holding the searched key.
+ * @param less The ordering of the list.
+ * @param context User pointer passed through to less.
+ * @param index Pointer where the index of the found item (or the item count) will be stored.
+ * @param item Pointer where the address of the found item (or NULL) will be stored, may be NULL.
+ * @return CHUNKED_LIST_SUCCESS on success, CHUNKED_LIST_ERROR_ALLOCATION_FAILED if memory allocation fails,
+ *         or CHUNKED_LIST_ERROR_INVALID_OPERATION in variable-length and slot-map mode.
+ */
+int chunked_list_upper_bound(CHUNKED_LIST_HANDLE list, const void* key, CHUNKED_LIST_LESS less, void* context,
+                             size_t* index, void** item);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHUNKED_LIST_SORTED_H
@@ -0,0 +1,72 @@
+#ifndef CHUNKED_LIST_STATS_H
+#define CHUNKED_LIST_STATS_H
+
+#include <stdint.h>
+#include "chunked_list.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Number of occupancy histogram buckets, bucket i counts chunks filled to [i*10%, (i+1)*10%)
+#define CHUNKED_LIST_STATS_HISTOGRAM_BUCKETS 10
+
+/// Statistics of a chunked list
+typedef struct {
+    // Layout, always available
+    size_t chunk_count;     // Number of chunks in the list
+    size_t empty_chunks;    // Number of chunks without items (e.g. after removals)
+    size_t spare_chunks;    // Number of chunks pre-allocated by chunked_list_reserve and not used yet
+    size_t shared_chunks;   // Number of chunks whose items are shared with snapshots
+    size_t bytes_reserved;  // Bytes allocated for chunks, including chunk headers and spare chunks, borrowed items excluded
+    size_t bytes_used;      // Bytes occupied by items, uncompressed
+    size_t compressed_chunks;   // Number of chunks compressed by chunked_list_compress_cold
+    size_t bytes_compressed;    // Encoded bytes of the compressed chunks
+    double compression_ratio;   // Uncompressed bytes of the compressed chunks divided by bytes_compressed, 0 if there are none
+    size_t occupancy_histogram[CHUNKED_LIST_STATS_HISTOGRAM_BUCKETS]; // Chunks by fill level, full chunks in the last bucket
+
+    // Operation counters, only collected if the library is built with CHUNKED_LIST_ENABLE_STATS
+    int counters_enabled;          // Non-zero if the counters below are collected
+    size_t add_count;              // Successful calls of chunked_list_add
+    size_t expand_count;           // Successful calls of chunked_list_expand, including the ones made by add
+    size_t insert_count;           // Successful calls of chunked_list_insert
+    size_t at_count;               // Calls of chunked_list_at, not counted in reader-safe lists
+    size_t remove_count;           // Successful calls of chunked_list_remove and chunked_list_remove_slot
+    size_t clear_count;            // Calls of chunked_list_clear
+    size_t search_count;           // Calls of chunked_list_lower_bound and chunked_list_upper_bound
+    size_t scan_count;             // Calls of chunked_list_scan_range
+    size_t scan_chunks_skipped;    // Chunks skipped by range scans using their key summary
+    size_t chunk_allocations;      // Chunks and slabs of chunks allocated with malloc
+    size_t at_chunks_walked;       // Chunks visited by chunked_list_at
+    double avg_at_chunks_walked;   // Average number of chunks visited per chunked_list_at call
+    size_t compress_count;         // Chunks compressed by chunked_list_compress_cold
+    size_t decompress_count;       // Chunks decompressed on access
+    uint64_t decompress_ns;        // Total time spent decompressing chunks, in nanoseconds
+    double avg_decompress_ns;      // Average time to decompress a chunk, in nanoseconds
+} CHUNKED_LIST_STATS;
+
+/**
+ * @brief Collects the statistics of a chunked list.
+ *
+ * The layout figures are computed by walking the chunks. The operation counters are
+ * zero unless the library is built with CHUNKED_LIST_ENABLE_STATS.
+ *
+ * @param list A handle to the chunked list.
+ * @param stats Pointer to the structure receiving the statistics.
+ * @return CHUNKED_LIST_SUCCESS on success.
+ */
+int chunked_list_get_stats(CHUNKED_LIST_HANDLE list, CHUNKED_LIST_STATS* stats);
+
+/**
+ * @brief Resets the operation counters of a chunked list.
+ *
+ * @param list A handle to the chunked list.
+ * @return CHUNKED_LIST_SUCCESS on success.
+ */
+int chunked_list_reset_stats(CHUNKED_LIST_HANDLE list);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHUNKED_LIST_STATS_H
@@ -2,97 +2,466 @@
 #include <string.h>
 
 #include "chunked_list.h"
+#include "chunked_list_bytes.h"
+#include "chunked_list_numa.h"
+#include "chunked_list_readers.h"
+#include "chunked_list_slots.h"
 #include "chunked_list_imp.h"
 
 // Function to create a new chunked_list
 CHUNKED_LIST_HANDLE chunked_list_create(size_t item_size, size_t chunk_size) {
+    return chunked_list_create_ex(item_size, chunk_size, 0);
+}
+
+// Function to create a new chunked_list in a specific mode
+CHUNKED_LIST_HANDLE chunked_list_create_ex(size_t item_size, size_t chunk_size, unsigned flags) {
+    // The modes are exclusive, e.g. readers could see a variable-length item count that does not
+    // match its used bytes, and slot maps update items in place
+    unsigned modes = flags & (CHUNKED_LIST_FLAG_VARIABLE_LENGTH | CHUNKED_LIST_FLAG_READER_SAFE | CHUNKED_LIST_FLAG_SLOT_MAP);
+    if (modes & (modes - 1)) {
+        return NULL;
+    }
+
     ChunkedList* chunked_list = (ChunkedList*)malloc(sizeof(ChunkedList));
     if (!chunked_list) {
         return NULL;
     }
 
-    chunked_list->item_size = item_size;
+    chunked_list->flags = flags;
+    chunked_list->item_size = (flags & CHUNKED_LIST_FLAG_VARIABLE_LENGTH) ? 0 : item_size;
     chunked_list->chunk_size = chunk_size;
     chunked_list->total_items = 0;
     chunked_list->head = NULL;
     chunked_list->tail = NULL;
+    chunked_list->spare = NULL;
+    chunked_list->spare_count = 0;
+    chunked_list->key_extractor = NULL;
+    chunked_list->chunk_index = NULL;
+    chunked_list->chunk_index_count = 0;
+    chunked_list->chunk_index_capacity = 0;
+    chunked_list->chunk_index_valid = 0;
+    chunked_list->sweep_count = 0;
+    chunked_list->epoch = 1;
+    chunked_list->readers = NULL;
+    chunked_list->retired = NULL;
+    chunked_list->retired_count = 0;
+    chunked_list->retired_capacity = 0;
+    chunked_list->numa_policy = CHUNKED_LIST_NUMA_LOCAL;
+    chunked_list->numa_node = 0;
+    chunked_list->numa_refill = 0;
+    chunked_list->slots_per_chunk = 0;
+    chunked_list->slot_header_size = 0;
+    chunked_list->slot_chunks = NULL;
+    chunked_list->slot_chunk_count = 0;
+    chunked_list->slot_chunk_capacity = 0;
+    chunked_list->free_slots = NULL;
+    chunked_list->free_slot_count = 0;
+    chunked_list->free_slot_capacity = 0;
+    chunked_list->slot_generation = 1;
+    if ((flags & CHUNKED_LIST_FLAG_SLOT_MAP) && !init_slot_layout(chunked_list)) {
+        free(chunked_list);
+        return NULL;
+    }
+#ifdef CHUNKED_LIST_ENABLE_STATS
+    memset(&chunked_list->counters, 0, sizeof(ChunkedListCounters));
+#endif
 
     return chunked_list;
 }
 
+// Function to get the flags of the chunked_list
+unsigned chunked_list_flags(CHUNKED_LIST_HANDLE list) {
+    ChunkedList* chunked_list = (ChunkedList*)list;
+    return chunked_list->flags;
+}
+
+// Function to unlink and release all chunks, retiring the linked ones if readers may still hold them
+static void release_chunks(ChunkedList* chunked_list, int retire) {
+    if (CHUNKED_LIST_IS_SLOT_MAP(chunked_list)) {
+        reset_slots(chunked_list);
+    }
+    Chunk* current = chunked_list->head;
+    CHUNKED_LIST_ATOMIC_STORE_PTR(&chunked_list->head, NULL);
+    CHUNKED_LIST_ATOMIC_STORE_SIZE(&chunked_list->total_items, 0);
+    while (current) {
+        Chunk* next = current->next;
+        if (retire) {
+            retire_chunk(chunked_list, current);
+        } else {
+            destroy_chunk(current);
+        }
+        current = next;
+    }
+    if (retire) {
+        end_retire_batch(chunked_list);
+    }
+    release_spare_chunks(chunked_list);
+    chunked_list->tail = NULL;
+    chunked_list->chunk_index_valid = 0;
+}
+
+// Function to release the chunks of the spare chain
+void release_spare_chunks(ChunkedList* chunked_list) {
+    Chunk* current = chunked_list->spare;
+    while (current) {
+        Chunk* next = current->next;
+        destroy_chunk(current);
+        current = next;
+    }
+    chunked_list->spare = NULL;
+    chunked_list->spare_count = 0;
+}
+
 // Function to delete the chunked_list and free all resources
 int chunked_list_destroy(CHUNKED_LIST_HANDLE list) {
-    chunked_list_clear(list);
+    ChunkedList* chunked_list = (ChunkedList*)list;
+    // No reader may be left, so all chunks, including the retired ones, can go
+    release_chunks(chunked_list, 0);
+    for (size_t idx = 0; idx < chunked_list->retired_count; ++idx) {
+        destroy_chunk(chunked_list->retired[idx].chunk);
+    }
+    free(chunked_list->retired);
+    ReaderSlot* reader = chunked_list->readers;
+    while (reader) {
+        ReaderSlot* next = reader->next;
+        free(reader->allocation);
+        reader = next;
+    }
+
+    free(chunked_list->slot_chunks);
+    free(chunked_list->free_slots);
+    free(chunked_list->chunk_index);
     free(list);
     return CHUNKED_LIST_SUCCESS;
 }
 
 int chunked_list_clear(CHUNKED_LIST_HANDLE list){
     ChunkedList* chunked_list = (ChunkedList*)list;
-    Chunk* current = chunked_list->head;
-    while (current) {
-        Chunk* next = current->next;
-        free(current);
-        current = next;
+    int retire = CHUNKED_LIST_IS_READER_SAFE(chunked_list) != 0;
+    if (retire) {
+        // Make room for all chunks up front, so that the list stays intact if there is none
+        size_t chunk_count = 0;
+        for (Chunk* current = chunked_list->head; current; current = current->next) {
+            chunk_count++;
+        }
+        if (reserve_retired(chunked_list, chunk_count) != CHUNKED_LIST_SUCCESS) {
+            return CHUNKED_LIST_ERROR_ALLOCATION_FAILED;
+        }
     }
-	chunked_list->total_items = 0;
-    chunked_list->head = NULL;
-    chunked_list->tail = NULL;
-	
+    CHUNKED_LIST_STAT_INC(chunked_list, clear_count);
+    release_chunks(chunked_list, retire);
     return CHUNKED_LIST_SUCCESS;
 }
 
+// Function to initialize the header of an empty chunk
+static void init_chunk(Chunk* chunk, ChunkSlab* slab, size_t capacity) {
+    chunk->next = NULL;
+    chunk->slab = slab;
+    chunk->source = NULL;
+    chunk->refcount = 1;
+    chunk->capacity = capacity;
+    chunk->used = 0;
+    chunk->item_count = 0;
+    chunk->key_count = 0;
+    chunk->compressed_size = 0;
+    chunk->last_access = 0;
+    chunk->node = slab ? slab->node : current_numa_node();
+    chunk->data = chunk->payload;
+}
+
 // Function to create a new chunk
 Chunk* create_chunk(size_t chunk_size) {
     Chunk* chunk = (Chunk*)malloc(sizeof(Chunk) + chunk_size);
     if (!chunk) {
         return NULL;
     }
-    chunk->next = NULL;
-    chunk->used = 0;
+    init_chunk(chunk, NULL, chunk_size);
     return chunk;
 }
 
-// Function to expands the chunked list for a new item
-int chunked_list_expand(CHUNKED_LIST_HANDLE list, void** pnewItem) {
+// Distance between two chunks of a slab
+static size_t slab_stride(size_t payload_size) {
+    return (sizeof(Chunk) + payload_size + CHUNK_ALIGNMENT - 1) / CHUNK_ALIGNMENT * CHUNK_ALIGNMENT;
+}
+
+// Offset of the first chunk of a slab
+static size_t slab_header_size(void) {
+    return (sizeof(ChunkSlab) + CHUNK_ALIGNMENT - 1) / CHUNK_ALIGNMENT * CHUNK_ALIGNMENT;
+}
+
+// Function to get the size of a slab of chunks
+size_t slab_size(size_t chunk_count, size_t payload_size) {
+    return slab_header_size() + chunk_count * slab_stride(payload_size);
+}
+
+// Function to allocate a slab of chunks
+ChunkSlab* create_slab(size_t chunk_count, size_t payload_size) {
+    ChunkSlab* slab = (ChunkSlab*)malloc(slab_size(chunk_count, payload_size));
+    if (!slab) {
+        return NULL;
+    }
+    slab->live_chunks = (long)chunk_count;
+    slab->node = current_numa_node();
+    slab->numa_size = 0;
+    return slab;
+}
+
+// Function to get a chunk of a slab
+Chunk* slab_chunk(ChunkSlab* slab, size_t idx, size_t payload_size) {
+    Chunk* chunk = (Chunk*)((char*)slab + slab_header_size() + idx * slab_stride(payload_size));
+    init_chunk(chunk, slab, payload_size);
+    return chunk;
+}
+
+// Function to release a chunk
+void destroy_chunk(Chunk* chunk) {
+    if (CHUNKED_LIST_ATOMIC_DEC(&chunk->refcount) != 0) {
+        return; // Still borrowed by a snapshot
+    }
+    if (chunk->source) {
+        destroy_chunk(chunk->source);
+    }
+
+    if (!chunk->slab) {
+        free(chunk);
+    } else if (CHUNKED_LIST_ATOMIC_DEC(&chunk->slab->live_chunks) == 0) {
+        free_slab(chunk->slab);
+    }
+}
+
+// Function to get an empty chunk for appending
+Chunk* acquire_chunk(ChunkedList* chunked_list) {
+    // Chunks placed by a NUMA policy come in batches from page-aligned slabs on their nodes
+    if (!chunked_list->spare && chunked_list->numa_policy != CHUNKED_LIST_NUMA_LOCAL &&
+        refill_numa_chunks(chunked_list) != CHUNKED_LIST_SUCCESS) {
+        return NULL;
+    }
+
+    Chunk* chunk = chunked_list->spare;
+    if (chunk) {
+        chunked_list->spare = chunk->next;
+        chunked_list->spare_count--;
+        chunk->next = NULL;
+        return chunk;
+    }
+
+    chunk = create_chunk(chunked_list->chunk_size);
+    if (chunk) {
+        CHUNKED_LIST_STAT_INC(chunked_list, chunk_allocations);
+    }
+    return chunk;
+}
+
+// Function to copy a shared chunk
+Chunk* unshare_chunk(ChunkedList* chunked_list, Chunk* chunk) {
+    Chunk* copy = chunk->capacity == chunked_list->chunk_size ? acquire_chunk(chunked_list) : create_chunk(chunk->capacity);
+    if (!copy) {
+        return NULL;
+    }
+    memcpy(copy->data, chunk->data, chunk->used);
+    if (chunk->item_count) {
+        memcpy(chunk_offsets(copy) - chunk->item_count, chunk_offsets(chunk) - chunk->item_count, chunk->item_count * sizeof(uint32_t));
+    }
+    copy->used = chunk->used;
+    copy->item_count = chunk->item_count;
+    copy->key_count = chunk->key_count;
+    copy->key_min = chunk->key_min;
+    copy->key_max = chunk->key_max;
+    copy->last_access = chunk->last_access;
+
+    if (replace_chunk(chunked_list, chunk, copy) != CHUNKED_LIST_SUCCESS) {
+        destroy_chunk(copy);
+        return NULL;
+    }
+    return copy;
+}
+
+// Function to swap a chunk for another one holding the same items
+int replace_chunk(ChunkedList* chunked_list, Chunk* chunk, Chunk* replacement) {
+    if (reserve_retired(chunked_list, 1) != CHUNKED_LIST_SUCCESS) {
+        return CHUNKED_LIST_ERROR_ALLOCATION_FAILED;
+    }
+
+    Chunk** link = &chunked_list->head;
+    while (*link != chunk) {
+        link = &(*link)->next;
+    }
+    replacement->next = chunk->next;
+    CHUNKED_LIST_ATOMIC_STORE_PTR(link, replacement);
+    if (chunked_list->tail == chunk) {
+        chunked_list->tail = replacement;
+    }
+
+    // The item indexes do not change, so a valid chunk index only needs the new pointer
+    if (chunked_list->chunk_index_valid) {
+        for (size_t idx = 0; idx < chunked_list->chunk_index_count; ++idx) {
+            if (chunked_list->chunk_index[idx].chunk == chunk) {
+                chunked_list->chunk_index[idx].chunk = replacement;
+                break;
+            }
+        }
+    }
+
+    if (CHUNKED_LIST_IS_READER_SAFE(chunked_list)) {
+        retire_chunk(chunked_list, chunk); // Readers may still be inside the old chunk
+        end_retire_batch(chunked_list);
+    } else {
+        destroy_chunk(chunk);
+    }
+    return CHUNKED_LIST_SUCCESS;
+}
+
+// Function to get the number of items a new chunk can hold
+static size_t items_per_chunk(const ChunkedList* chunked_list) {
+    return CHUNKED_LIST_IS_SLOT_MAP(chunked_list) ? chunked_list->slots_per_chunk
+                                                  : chunked_list->chunk_size / chunked_list->item_size;
+}
+
+// Function to get the number of items the list can hold before appending allocates memory
+size_t chunked_list_capacity(CHUNKED_LIST_HANDLE list) {
     ChunkedList* chunked_list = (ChunkedList*)list;
-    
+    if (CHUNKED_LIST_IS_VARIABLE_LENGTH(chunked_list)) {
+        return chunked_list->total_items;
+    }
+    size_t capacity = chunked_list->total_items + chunked_list->free_slot_count +
+                      chunked_list->spare_count * items_per_chunk(chunked_list);
+    if (chunked_list->tail && chunked_list->tail->used < chunked_list->tail->capacity) {
+        capacity += (chunked_list->tail->capacity - chunked_list->tail->used) / chunked_list->item_size;
+    }
+    return capacity;
+}
+
+// Function to pre-allocate chunks for at least n_items items
+int chunked_list_reserve(CHUNKED_LIST_HANDLE list, size_t n_items) {
+    ChunkedList* chunked_list = (ChunkedList*)list;
+    if (CHUNKED_LIST_IS_VARIABLE_LENGTH(chunked_list)) {
+        return CHUNKED_LIST_ERROR_INVALID_OPERATION;
+    }
+    size_t capacity = chunked_list_capacity(list);
+    if (n_items <= capacity) {
+        return CHUNKED_LIST_SUCCESS;
+    }
+
+    size_t chunk_items = items_per_chunk(chunked_list);
+    size_t chunk_count = (n_items - capacity + chunk_items - 1) / chunk_items;
+
+    if (chunked_list->numa_policy != CHUNKED_LIST_NUMA_LOCAL) {
+        return reserve_numa_chunks(chunked_list, chunk_count);
+    }
+
+    // Carve all chunks from a single allocation
+    ChunkSlab* slab = create_slab(chunk_count, chunked_list->chunk_size);
+    if (!slab) {
+        return CHUNKED_LIST_ERROR_ALLOCATION_FAILED;
+    }
+    CHUNKED_LIST_STAT_INC(chunked_list, chunk_allocations);
+
+    // Link the chunks in address order in front of the existing spare chunks
+    Chunk* next = chunked_list->spare;
+    for (size_t idx = chunk_count; idx > 0; --idx) {
+        Chunk* chunk = slab_chunk(slab, idx - 1, chunked_list->chunk_size);
+        chunk->next = next;
+        next = chunk;
+    }
+    chunked_list->spare = next;
+    chunked_list->spare_count += chunk_count;
+
+    return CHUNKED_LIST_SUCCESS;
+}
+
+// Function to find room for a new item at the end of the list, without making it visible yet
+static int prepare_append(ChunkedList* chunked_list, void** destination) {
     // Check if the tail chunk is full or doesn't exist
-    if (!chunked_list->tail || chunked_list->tail->used + chunked_list->item_size > chunked_list->chunk_size) {
-        Chunk* new_chunk = create_chunk(chunked_list->chunk_size);
+    if (!chunked_list->tail || chunked_list->tail->used + chunked_list->item_size > chunked_list->tail->capacity) {
+        Chunk* new_chunk = acquire_chunk(chunked_list);
         if (!new_chunk) {
             return CHUNKED_LIST_ERROR_ALLOCATION_FAILED;
         }
+        if (CHUNKED_LIST_IS_SLOT_MAP(chunked_list) && link_slot_chunk(chunked_list, new_chunk) != CHUNKED_LIST_SUCCESS) {
+            new_chunk->next = chunked_list->spare;
+            chunked_list->spare = new_chunk;
+            chunked_list->spare_count++;
+            return CHUNKED_LIST_ERROR_ALLOCATION_FAILED;
+        }
         
         if (!chunked_list->head) {
-            chunked_list->head = new_chunk;
+            CHUNKED_LIST_ATOMIC_STORE_PTR(&chunked_list->head, new_chunk);
         } else {
-            chunked_list->tail->next = new_chunk;
+            CHUNKED_LIST_ATOMIC_STORE_PTR(&chunked_list->tail->next, new_chunk);
         }
         
         chunked_list->tail = new_chunk;
     }
+
+    // Items borrowed from another list must not be appended to
+    if (chunked_list->tail->source && !unshare_chunk(chunked_list, chunked_list->tail)) {
+        return CHUNKED_LIST_ERROR_ALLOCATION_FAILED;
+    }
+
+    // An empty tail is not part of the chunk index yet
+    if (chunked_list->tail->used == 0) {
+        chunked_list->chunk_index_valid = 0;
+    }
     
-    // Expand the current tail chunk
-    void* destination = chunked_list->tail->data + chunked_list->tail->used;
-    chunked_list->tail->used += chunked_list->item_size;
-    chunked_list->total_items++;
-	*pnewItem = destination;
-	
+    *destination = chunked_list->tail->data + chunked_list->tail->used;
     return CHUNKED_LIST_SUCCESS;
 }
 
+// Function to make the item prepared by prepare_append visible, readers see it fully written
+static void publish_append(ChunkedList* chunked_list) {
+    CHUNKED_LIST_STAT_INC(chunked_list, expand_count);
+    Chunk* tail = chunked_list->tail;
+    tail->last_access = chunked_list->sweep_count;
+    CHUNKED_LIST_ATOMIC_STORE_SIZE(&tail->used, tail->used + chunked_list->item_size);
+    CHUNKED_LIST_ATOMIC_STORE_SIZE(&chunked_list->total_items, chunked_list->total_items + 1);
+}
+
+// Function to append an item without writing it
+int append_item(ChunkedList* chunked_list, void** destination) {
+    int error_code = prepare_append(chunked_list, destination);
+    if (CHUNKED_LIST_SUCCESS != error_code) {
+        return error_code;
+    }
+    publish_append(chunked_list);
+
+    return CHUNKED_LIST_SUCCESS;
+}
+
+// Function to expands the chunked list for a new item
+int chunked_list_expand(CHUNKED_LIST_HANDLE list, void** pnewItem) {
+    ChunkedList* chunked_list = (ChunkedList*)list;
+    if (CHUNKED_LIST_IS_VARIABLE_LENGTH(chunked_list) || CHUNKED_LIST_IS_READER_SAFE(chunked_list)) {
+        return CHUNKED_LIST_ERROR_INVALID_OPERATION;
+    }
+    if (CHUNKED_LIST_IS_SLOT_MAP(chunked_list)) {
+        return chunked_list_expand_slot(list, pnewItem, NULL);
+    }
+
+    return append_item(chunked_list, pnewItem);
+}
+
 // Function to add an item to the chunked_list
 int chunked_list_add(CHUNKED_LIST_HANDLE list, void* item) {
     ChunkedList* chunked_list = (ChunkedList*)list;
+    if (CHUNKED_LIST_IS_SLOT_MAP(chunked_list)) {
+        return chunked_list_add_slot(list, item, NULL);
+    }
+    if (CHUNKED_LIST_IS_VARIABLE_LENGTH(chunked_list)) {
+        return CHUNKED_LIST_ERROR_INVALID_OPERATION;
+    }
     
     // Add the item to the current tail chunk
     void* destination; 
-	int error_code = chunked_list_expand(list, &destination);
+	int error_code = prepare_append(chunked_list, &destination);
 	if(CHUNKED_LIST_SUCCESS != error_code)
 		return error_code;
 	
     memcpy(destination, item, chunked_list->item_size);
+    publish_append(chunked_list);
+    if (chunked_list->key_extractor) {
+        update_chunk_summary(chunked_list, chunked_list->tail);
+    }
+    CHUNKED_LIST_STAT_INC(chunked_list, add_count);
     
     return CHUNKED_LIST_SUCCESS;
 }
@@ -100,32 +469,54 @@ int chunked_list_add(CHUNKED_LIST_HANDLE list, void* item) {
 // Function to retrieve an item at a specific index
 int chunked_list_at(CHUNKED_LIST_HANDLE list, size_t index, void** item) {
     ChunkedList* chunked_list = (ChunkedList*)list;
-    if (index >= chunked_list->total_items) {
+    if (CHUNKED_LIST_IS_VARIABLE_LENGTH(chunked_list)) {
+        return chunked_list_at_bytes(list, index, item, NULL);
+    }
+    CHUNKED_LIST_READ_STAT_INC(chunked_list, at_count);
+    if (index >= CHUNKED_LIST_ATOMIC_LOAD_SIZE(&chunked_list->total_items)) {
         return CHUNKED_LIST_ERROR_INVALID_INDEX;
     }
+    if (CHUNKED_LIST_IS_SLOT_MAP(chunked_list)) {
+        size_t chunk_pos;
+        Chunk* chunk = locate_slot_item(chunked_list, index, &chunk_pos);
+        *item = chunk->data + chunk_pos * chunked_list->item_size;
+        return CHUNKED_LIST_SUCCESS;
+    }
 
     size_t items_to_skip = index;
-    Chunk* current_chunk = chunked_list->head;
+    Chunk* current_chunk = CHUNKED_LIST_ATOMIC_LOAD_PTR(&chunked_list->head);
     
     while (current_chunk) {
-        size_t chunk_items = current_chunk->used / chunked_list->item_size;
+        CHUNKED_LIST_READ_STAT_INC(chunked_list, at_chunks_walked);
+        size_t chunk_items = CHUNKED_LIST_ATOMIC_LOAD_SIZE(&current_chunk->used) / chunked_list->item_size;
         if (items_to_skip < chunk_items) {
+            current_chunk = touch_chunk(chunked_list, current_chunk);
+            if (!current_chunk) {
+                return CHUNKED_LIST_ERROR_ALLOCATION_FAILED;
+            }
             *item = (void*)(current_chunk->data + items_to_skip * chunked_list->item_size);
             return CHUNKED_LIST_SUCCESS;
         }
         items_to_skip -= chunk_items;
-        current_chunk = current_chunk->next;
+        current_chunk = CHUNKED_LIST_ATOMIC_LOAD_PTR(&current_chunk->next);
     }
 
     return CHUNKED_LIST_ERROR_INVALID_INDEX;
 }
 
-// Function to remove an item at a specific index
-int chunked_list_remove(CHUNKED_LIST_HANDLE list, size_t index) {
-    ChunkedList* chunked_list = (ChunkedList*)list;
+// Function to remove the item at index, in every mode of the list
+static int remove_item(ChunkedList* chunked_list, size_t index) {
     if (index >= chunked_list->total_items) {
         return CHUNKED_LIST_ERROR_INVALID_INDEX;
     }
+    if (CHUNKED_LIST_IS_VARIABLE_LENGTH(chunked_list)) {
+        return remove_bytes_item(chunked_list, index);
+    }
+    if (CHUNKED_LIST_IS_SLOT_MAP(chunked_list)) {
+        size_t chunk_pos;
+        Chunk* chunk = locate_slot_item(chunked_list, index, &chunk_pos);
+        return free_slot(chunked_list, chunk, chunk_pos);
+    }
 
     size_t items_to_skip = index;
     Chunk* current_chunk = chunked_list->head;
@@ -134,8 +525,24 @@ int chunked_list_remove(CHUNKED_LIST_HANDLE list, size_t index) {
         size_t chunk_items = current_chunk->used / chunked_list->item_size;
         if (items_to_skip < chunk_items) {
             // Found the chunk containing the item to chunked_list_remove
+            current_chunk = touch_chunk(chunked_list, current_chunk);
+            if (!current_chunk) {
+                return CHUNKED_LIST_ERROR_ALLOCATION_FAILED;
+            }
+            if (CHUNKED_LIST_IS_READER_SAFE(chunked_list)) {
+                return remove_by_copy(chunked_list, current_chunk, items_to_skip);
+            }
+            if (!CHUNK_IS_EXCLUSIVE(current_chunk)) {
+                current_chunk = unshare_chunk(chunked_list, current_chunk);
+                if (!current_chunk) {
+                    return CHUNKED_LIST_ERROR_ALLOCATION_FAILED;
+                }
+            }
             char* item_to_remove = current_chunk->data + items_to_skip * chunked_list->item_size;
             char* next_item = item_to_remove + chunked_list->item_size;
+            if (chunked_list->key_extractor) {
+                remove_from_chunk_summary(chunked_list, current_chunk, items_to_skip);
+            }
             
             // Shift all items in the chunk after the item_to_remove to fill the gap
             size_t remaining_items_in_chunk = chunk_items - items_to_skip - 1;  // Items after the removed one
@@ -146,6 +553,7 @@ int chunked_list_remove(CHUNKED_LIST_HANDLE list, size_t index) {
             // Reduce the used size in the current chunk
             current_chunk->used -= chunked_list->item_size;
             chunked_list->total_items--;
+            chunked_list->chunk_index_valid = 0;
             
             return CHUNKED_LIST_SUCCESS;
         }
@@ -156,9 +564,130 @@ int chunked_list_remove(CHUNKED_LIST_HANDLE list, size_t index) {
     return CHUNKED_LIST_ERROR_INVALID_INDEX;
 }
 
+// Function to remove an item at a specific index
+int chunked_list_remove(CHUNKED_LIST_HANDLE list, size_t index) {
+    ChunkedList* chunked_list = (ChunkedList*)list;
+    int error_code = remove_item(chunked_list, index);
+    if (CHUNKED_LIST_SUCCESS == error_code) {
+        CHUNKED_LIST_STAT_INC(chunked_list, remove_count);
+    }
+    return error_code;
+}
+
+// Function to find the chunk holding the item at index, using the chunk index when it is valid
+static Chunk* locate_chunk(ChunkedList* chunked_list, size_t index, size_t* chunk_pos, size_t* entry) {
+    if (chunked_list->chunk_index_valid) {
+        size_t low = 0;
+        size_t high = chunked_list->chunk_index_count;
+        while (high - low > 1) {
+            size_t middle = low + (high - low) / 2;
+            if (chunked_list->chunk_index[middle].first_index <= index) {
+                low = middle;
+            } else {
+                high = middle;
+            }
+        }
+        *chunk_pos = index - chunked_list->chunk_index[low].first_index;
+        *entry = low;
+        return chunked_list->chunk_index[low].chunk;
+    }
+
+    size_t items_to_skip = index;
+    Chunk* current_chunk = chunked_list->head;
+    while (current_chunk) {
+        size_t chunk_items = current_chunk->used / chunked_list->item_size;
+        if (items_to_skip < chunk_items) {
+            break;
+        }
+        items_to_skip -= chunk_items;
+        current_chunk = current_chunk->next;
+    }
+    *chunk_pos = items_to_skip;
+    return current_chunk;
+}
+
+// Function to insert a new item at a specific index
+int chunked_list_insert(CHUNKED_LIST_HANDLE list, size_t index, void** pnewItem) {
+    ChunkedList* chunked_list = (ChunkedList*)list;
+    if (CHUNKED_LIST_IS_VARIABLE_LENGTH(chunked_list) || CHUNKED_LIST_IS_READER_SAFE(chunked_list) ||
+        CHUNKED_LIST_IS_SLOT_MAP(chunked_list)) {
+        return CHUNKED_LIST_ERROR_INVALID_OPERATION;
+    }
+    if (index > chunked_list->total_items) {
+        return CHUNKED_LIST_ERROR_INVALID_INDEX;
+    }
+    if (index == chunked_list->total_items) {
+        int error_code = chunked_list_expand(list, pnewItem);
+        if (CHUNKED_LIST_SUCCESS == error_code) {
+            CHUNKED_LIST_STAT_INC(chunked_list, insert_count);
+        }
+        return error_code;
+    }
+
+    size_t chunk_pos;
+    size_t entry = 0;
+    Chunk* current_chunk = touch_chunk(chunked_list, locate_chunk(chunked_list, index, &chunk_pos, &entry));
+    if (!current_chunk) {
+        return CHUNKED_LIST_ERROR_ALLOCATION_FAILED;
+    }
+    if (!CHUNK_IS_EXCLUSIVE(current_chunk)) {
+        current_chunk = unshare_chunk(chunked_list, current_chunk);
+        if (!current_chunk) {
+            return CHUNKED_LIST_ERROR_ALLOCATION_FAILED;
+        }
+    }
+    size_t chunk_items = current_chunk->used / chunked_list->item_size;
+
+    if (current_chunk->used + chunked_list->item_size > current_chunk->capacity) {
+        // Split the full chunk and move its upper half into a new chunk of the same capacity
+        Chunk* new_chunk = current_chunk->capacity == chunked_list->chunk_size ? acquire_chunk(chunked_list)
+                                                                               : create_chunk(current_chunk->capacity);
+        if (!new_chunk) {
+            return CHUNKED_LIST_ERROR_ALLOCATION_FAILED;
+        }
+
+        size_t keep_items = chunk_items / 2;
+        new_chunk->used = (chunk_items - keep_items) * chunked_list->item_size;
+        memcpy(new_chunk->data, current_chunk->data + keep_items * chunked_list->item_size, new_chunk->used);
+        current_chunk->used = keep_items * chunked_list->item_size;
+        current_chunk->key_count = 0;
+
+        new_chunk->next = current_chunk->next;
+        current_chunk->next = new_chunk;
+        if (chunked_list->tail == current_chunk) {
+            chunked_list->tail = new_chunk;
+        }
+        chunked_list->chunk_index_valid = 0;
+
+        if (chunk_pos > keep_items) {
+            current_chunk = new_chunk;
+            chunk_pos -= keep_items;
+        }
+        chunk_items = current_chunk->used / chunked_list->item_size;
+    } else if (chunked_list->chunk_index_valid) {
+        // Only the first indexes of the following chunks move
+        for (size_t idx = entry + 1; idx < chunked_list->chunk_index_count; ++idx) {
+            chunked_list->chunk_index[idx].first_index++;
+        }
+    }
+
+    // Shift the items after the insert position to make room for the new one
+    char* destination = current_chunk->data + chunk_pos * chunked_list->item_size;
+    memmove(destination + chunked_list->item_size, destination, (chunk_items - chunk_pos) * chunked_list->item_size);
+    current_chunk->used += chunked_list->item_size;
+    if (chunk_pos < current_chunk->key_count) {
+        current_chunk->key_count = 0;
+    }
+    chunked_list->total_items++;
+    *pnewItem = destination;
+    CHUNKED_LIST_STAT_INC(chunked_list, insert_count);
+
+    return CHUNKED_LIST_SUCCESS;
+}
+
 // Function to get the total number of items in the chunked_list
 size_t chunked_list_count(CHUNKED_LIST_HANDLE list) {
     ChunkedList* chunked_list = (ChunkedList*)list;
-    return chunked_list->total_items;
+    return CHUNKED_LIST_ATOMIC_LOAD_SIZE(&chunked_list->total_items);
 }
 
@@ -0,0 +1,127 @@
+#include <stddef.h>
+#include <string.h>
+
+#include "chunked_list_bytes.h"
+#include "chunked_list_imp.h"
+
+// The offset table ends at the last 4-byte boundary of the payload, entry i is at [-1 - i]
+uint32_t* chunk_offsets(const Chunk* chunk) {
+    return (uint32_t*)(chunk->data + (chunk->capacity & ~(size_t)3));
+}
+
+char* chunk_bytes_item(const Chunk* chunk, size_t chunk_pos, size_t* length) {
+    const uint32_t* offsets = chunk_offsets(chunk);
+    size_t begin = offsets[-1 - (ptrdiff_t)chunk_pos];
+    if (length) {
+        size_t end = chunk_pos + 1 < chunk->item_count ? offsets[-2 - (ptrdiff_t)chunk_pos] : chunk->used;
+        *length = end - begin;
+    }
+    return chunk->data + begin;
+}
+
+// Free bytes between the items and the offset table of a chunk
+static size_t chunk_bytes_free(const Chunk* chunk) {
+    return (chunk->capacity & ~(size_t)3) - chunk->used - chunk->item_count * sizeof(uint32_t);
+}
+
+int chunked_list_add_bytes(CHUNKED_LIST_HANDLE list, const void* item, size_t length) {
+    ChunkedList* chunked_list = (ChunkedList*)list;
+    if (!CHUNKED_LIST_IS_VARIABLE_LENGTH(chunked_list) || length > UINT32_MAX) {
+        return CHUNKED_LIST_ERROR_INVALID_OPERATION;
+    }
+    size_t needed = length + sizeof(uint32_t);
+    if (!chunked_list->tail || chunk_bytes_free(chunked_list->tail) < needed) {
+        // Items that do not fit in a regular chunk get a chunk of their own size
+        size_t regular = chunked_list->chunk_size & ~(size_t)3;
+        Chunk* new_chunk = needed <= regular ? acquire_chunk(chunked_list)
+                                             : create_chunk((needed + 3) & ~(size_t)3);
+        if (!new_chunk) {
+            return CHUNKED_LIST_ERROR_ALLOCATION_FAILED;
+        }
+        if (needed > regular) {
+            CHUNKED_LIST_STAT_INC(chunked_list, chunk_allocations);
+        }
+
+        if (!chunked_list->head) {
+            chunked_list->head = new_chunk;
+        } else {
+            chunked_list->tail->next = new_chunk;
+        }
+        chunked_list->tail = new_chunk;
+    }
+
+    // Items borrowed from another list must not be appended to
+    if (chunked_list->tail->source && !unshare_chunk(chunked_list, chunked_list->tail)) {
+        return CHUNKED_LIST_ERROR_ALLOCATION_FAILED;
+    }
+
+    Chunk* tail = chunked_list->tail;
+    chunk_offsets(tail)[-1 - (ptrdiff_t)tail->item_count] = (uint32_t)tail->used;
+    if (length) {
+        memcpy(tail->data + tail->used, item, length);
+    }
+    tail->used += length;
+    tail->item_count++;
+    chunked_list->total_items++;
+    CHUNKED_LIST_STAT_INC(chunked_list, add_count);
+
+    return CHUNKED_LIST_SUCCESS;
+}
+
+int chunked_list_at_bytes(CHUNKED_LIST_HANDLE list, size_t index, void** item, size_t* length) {
+    ChunkedList* chunked_list = (ChunkedList*)list;
+    if (!CHUNKED_LIST_IS_VARIABLE_LENGTH(chunked_list)) {
+        return CHUNKED_LIST_ERROR_INVALID_OPERATION;
+    }
+    CHUNKED_LIST_READ_STAT_INC(chunked_list, at_count);
+    if (index >= chunked_list->total_items) {
+        return CHUNKED_LIST_ERROR_INVALID_INDEX;
+    }
+
+    size_t items_to_skip = index;
+    for (Chunk* current_chunk = chunked_list->head; current_chunk; current_chunk = current_chunk->next) {
+        CHUNKED_LIST_READ_STAT_INC(chunked_list, at_chunks_walked);
+        if (items_to_skip < current_chunk->item_count) {
+            *item = chunk_bytes_item(current_chunk, items_to_skip, length);
+            return CHUNKED_LIST_SUCCESS;
+        }
+        items_to_skip -= current_chunk->item_count;
+    }
+
+    return CHUNKED_LIST_ERROR_INVALID_INDEX;
+}
+
+int remove_bytes_item(ChunkedList* chunked_list, size_t index) {
+    size_t items_to_skip = index;
+    for (Chunk* current_chunk = chunked_list->head; current_chunk; current_chunk = current_chunk->next) {
+        if (items_to_skip >= current_chunk->item_count) {
+            items_to_skip -= current_chunk->item_count;
+            continue;
+        }
+
+        if (!CHUNK_IS_EXCLUSIVE(current_chunk)) {
+            current_chunk = unshare_chunk(chunked_list, current_chunk);
+            if (!current_chunk) {
+                return CHUNKED_LIST_ERROR_ALLOCATION_FAILED;
+            }
+        }
+
+        size_t length;
+        char* item_to_remove = chunk_bytes_item(current_chunk, items_to_skip, &length);
+        char* next_item = item_to_remove + length;
+        memmove(item_to_remove, next_item, (size_t)(current_chunk->data + current_chunk->used - next_item));
+
+        // Close the gap in the offset table, the following items moved down by length
+        uint32_t* offsets = chunk_offsets(current_chunk);
+        for (size_t pos = items_to_skip + 1; pos < current_chunk->item_count; ++pos) {
+            offsets[-(ptrdiff_t)pos] = offsets[-1 - (ptrdiff_t)pos] - (uint32_t)length;
+        }
+
+        current_chunk->used -= length;
+        current_chunk->item_count--;
+        chunked_list->total_items--;
+        return CHUNKED_LIST_SUCCESS;
+    }
+
+    return CHUNKED_LIST_ERROR_INVALID_INDEX;
+}
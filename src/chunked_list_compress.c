@@ -0,0 +1,250 @@
+#include <stdlib.h>
+#include <string.h>
+#ifdef CHUNKED_LIST_ENABLE_STATS
+#include <time.h>
+#endif
+
+#include "chunked_list_compress.h"
+#include "chunked_list_imp.h"
+
+// Items are encoded as words of the largest width dividing the item size
+static size_t word_width(size_t item_size) {
+    return (item_size % 8) == 0 ? 8 : (item_size % 4) == 0 ? 4 : 1;
+}
+
+static uint64_t load_word(const char* src, size_t width) {
+    uint64_t word64;
+    uint32_t word32;
+    switch (width) {
+    case 8:
+        memcpy(&word64, src, 8);
+        return word64;
+    case 4:
+        memcpy(&word32, src, 4);
+        return word32;
+    default:
+        return (unsigned char)*src;
+    }
+}
+
+static void store_word(char* dst, uint64_t word, size_t width) {
+    uint32_t word32 = (uint32_t)word;
+    switch (width) {
+    case 8:
+        memcpy(dst, &word, 8);
+        break;
+    case 4:
+        memcpy(dst, &word32, 4);
+        break;
+    default:
+        *dst = (char)word;
+        break;
+    }
+}
+
+// Append a LEB128 varint, returns the new output position or 0 if it would pass limit
+static size_t put_varint(char* out, size_t pos, size_t limit, uint64_t value) {
+    do {
+        if (pos >= limit) {
+            return 0;
+        }
+        unsigned char byte = (unsigned char)(value & 0x7f);
+        value >>= 7;
+        out[pos++] = (char)(value ? byte | 0x80 : byte);
+    } while (value);
+    return pos;
+}
+
+static const char* get_varint(const char* in, uint64_t* value) {
+    unsigned shift = 0;
+    *value = 0;
+    unsigned char byte;
+    do {
+        byte = (unsigned char)*in++;
+        *value |= (uint64_t)(byte & 0x7f) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+    return in;
+}
+
+// Zigzag code of the difference of two words, small positive and negative steps get small codes
+static uint64_t delta_code(uint64_t word, uint64_t previous, size_t width) {
+    unsigned shift = (unsigned)(64 - 8 * width);
+    int64_t delta = (int64_t)((word - previous) << shift) >> shift;
+    return ((uint64_t)delta << 1) ^ (uint64_t)(delta >> 63);
+}
+
+static uint64_t apply_delta_code(uint64_t previous, uint64_t code, size_t width) {
+    uint64_t word = previous + ((code >> 1) ^ (0 - (code & 1)));
+    return width == 8 ? word : word & ((UINT64_C(1) << (8 * width)) - 1);
+}
+
+// Encode used bytes of items into out, returns the encoded size or 0 if it exceeds limit.
+// Every word is coded against the same word of the previous item, a zero code is followed
+// by the length of its run of zero codes
+static size_t encode_items(const char* src, size_t used, size_t item_size, char* out, size_t limit) {
+    size_t width = word_width(item_size);
+    size_t word_count = used / width;
+    size_t stride = item_size / width;
+    size_t pos = 0;
+
+    for (size_t idx = 0; idx < word_count;) {
+        uint64_t previous = idx >= stride ? load_word(src + (idx - stride) * width, width) : 0;
+        uint64_t code = delta_code(load_word(src + idx * width, width), previous, width);
+        pos = put_varint(out, pos, limit, code);
+        idx++;
+        if (pos && code == 0) {
+            size_t run = 0;
+            while (idx < word_count) {
+                previous = idx >= stride ? load_word(src + (idx - stride) * width, width) : 0;
+                if (load_word(src + idx * width, width) != previous) {
+                    break;
+                }
+                run++;
+                idx++;
+            }
+            pos = put_varint(out, pos, limit, run);
+        }
+        if (!pos) {
+            return 0;
+        }
+    }
+    return pos;
+}
+
+// Decode the first used bytes of items encoded by encode_items into dst
+static void decode_items(const char* in, size_t used, size_t item_size, char* dst) {
+    size_t width = word_width(item_size);
+    size_t word_count = used / width;
+    size_t stride = item_size / width;
+
+    for (size_t idx = 0; idx < word_count;) {
+        uint64_t code;
+        in = get_varint(in, &code);
+        uint64_t run = 0;
+        if (code == 0) {
+            in = get_varint(in, &run);
+        }
+        for (run++; run > 0 && idx < word_count; --run, ++idx) {
+            uint64_t previous = idx >= stride ? load_word(dst + (idx - stride) * width, width) : 0;
+            store_word(dst + idx * width, apply_delta_code(previous, code, width), width);
+        }
+    }
+}
+
+#ifdef CHUNKED_LIST_ENABLE_STATS
+static uint64_t now_ns(void) {
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+#endif
+
+Chunk* touch_chunk(ChunkedList* chunked_list, Chunk* chunk) {
+    if (CHUNKED_LIST_IS_READER_SAFE(chunked_list)) {
+        return chunk; // Readers must not write to the list, chunks are never compressed
+    }
+    if (!chunk->compressed_size) {
+        chunk->last_access = chunked_list->sweep_count;
+        return chunk;
+    }
+
+#ifdef CHUNKED_LIST_ENABLE_STATS
+    uint64_t start = now_ns();
+#endif
+    Chunk* plain = acquire_chunk(chunked_list);
+    if (!plain) {
+        return NULL;
+    }
+    decode_items(chunk->data, chunk->used, chunked_list->item_size, plain->data);
+    plain->used = chunk->used;
+    plain->key_count = chunk->key_count;
+    plain->key_min = chunk->key_min;
+    plain->key_max = chunk->key_max;
+    plain->last_access = chunked_list->sweep_count;
+    if (replace_chunk(chunked_list, chunk, plain) != CHUNKED_LIST_SUCCESS) {
+        destroy_chunk(plain);
+        return NULL;
+    }
+
+    CHUNKED_LIST_STAT_INC(chunked_list, decompress_count);
+    CHUNKED_LIST_STAT_ADD(chunked_list, decompress_ns, now_ns() - start);
+    return plain;
+}
+
+const char* chunk_first_item(const ChunkedList* chunked_list, const Chunk* chunk, char* buffer) {
+    if (!chunk->compressed_size) {
+        return chunk->data;
+    }
+    // The first item is coded against zero, so it decodes on its own
+    decode_items(chunk->data, chunked_list->item_size, chunked_list->item_size, buffer);
+    return buffer;
+}
+
+int chunked_list_compress_cold(CHUNKED_LIST_HANDLE list, size_t min_idle_sweeps, size_t* compressed_chunks) {
+    ChunkedList* chunked_list = (ChunkedList*)list;
+    if (CHUNKED_LIST_IS_VARIABLE_LENGTH(chunked_list) || CHUNKED_LIST_IS_READER_SAFE(chunked_list) ||
+        CHUNKED_LIST_IS_SLOT_MAP(chunked_list)) {
+        return CHUNKED_LIST_ERROR_INVALID_OPERATION;
+    }
+
+    size_t count = 0;
+    char* buffer = NULL;
+    int error_code = CHUNKED_LIST_SUCCESS;
+    Chunk* next;
+    for (Chunk* current = chunked_list->head; current; current = next) {
+        next = current->next;
+        int full = current->used + chunked_list->item_size > current->capacity;
+        if (!full || current->compressed_size || !CHUNK_IS_EXCLUSIVE(current) ||
+            current->last_access + min_idle_sweeps > chunked_list->sweep_count) {
+            continue;
+        }
+
+        if (!buffer) {
+            buffer = (char*)malloc(chunked_list->chunk_size);
+            if (!buffer) {
+                error_code = CHUNKED_LIST_ERROR_ALLOCATION_FAILED;
+                break;
+            }
+        }
+
+        // Range scans must not read compressed items to complete the key summary
+        if (chunked_list->key_extractor) {
+            update_chunk_summary(chunked_list, current);
+        }
+
+        size_t limit = current->used - current->used / 4;
+        size_t encoded = encode_items(current->data, current->used, chunked_list->item_size, buffer, limit);
+        if (!encoded) {
+            continue; // Not worth it
+        }
+
+        Chunk* compressed = create_chunk(encoded);
+        if (!compressed) {
+            error_code = CHUNKED_LIST_ERROR_ALLOCATION_FAILED;
+            break;
+        }
+        CHUNKED_LIST_STAT_INC(chunked_list, chunk_allocations);
+        memcpy(compressed->data, buffer, encoded);
+        compressed->compressed_size = encoded;
+        compressed->used = current->used;
+        compressed->key_count = current->key_count;
+        compressed->key_min = current->key_min;
+        compressed->key_max = current->key_max;
+        compressed->last_access = current->last_access;
+        error_code = replace_chunk(chunked_list, current, compressed);
+        if (CHUNKED_LIST_SUCCESS != error_code) {
+            destroy_chunk(compressed);
+            break;
+        }
+        CHUNKED_LIST_STAT_INC(chunked_list, compress_count);
+        count++;
+    }
+
+    free(buffer);
+    chunked_list->sweep_count++;
+    if (compressed_chunks) {
+        *compressed_chunks = count;
+    }
+    return error_code;
+}
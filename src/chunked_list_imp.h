@@ -1,18 +1,302 @@
 #ifndef CHUNKED_LIST_IMP_H
 #define CHUNKED_LIST_IMP_H
 
+#include <stdint.h>
+
+#include "chunked_list_scan.h"
+
+// Alignment of chunks carved from a slab, matches the alignment guaranteed by malloc
+#define CHUNK_ALIGNMENT 16
+
+// Atomic reference counting, chunks may be released by threads holding snapshots
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define CHUNKED_LIST_ATOMIC_INC(ptr) _InterlockedIncrement((volatile long*)(ptr))
+#define CHUNKED_LIST_ATOMIC_DEC(ptr) _InterlockedDecrement((volatile long*)(ptr))
+#define CHUNKED_LIST_ATOMIC_LOAD(ptr) (*(volatile long*)(ptr))
+#else
+#define CHUNKED_LIST_ATOMIC_INC(ptr) __atomic_add_fetch((ptr), 1, __ATOMIC_RELAXED)
+#define CHUNKED_LIST_ATOMIC_DEC(ptr) __atomic_sub_fetch((ptr), 1, __ATOMIC_ACQ_REL)
+#define CHUNKED_LIST_ATOMIC_LOAD(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#endif
+
+// Publication of links and sizes read by concurrent readers in reader-safe mode: stores release
+// everything written before them, loads acquire it. MSVC gives volatile accesses these semantics
+#if defined(_MSC_VER)
+#define CHUNKED_LIST_ATOMIC_LOAD_PTR(ptr) (*(void* volatile*)(ptr))
+#define CHUNKED_LIST_ATOMIC_STORE_PTR(ptr, value) (*(void* volatile*)(ptr) = (value))
+#define CHUNKED_LIST_ATOMIC_LOAD_SIZE(ptr) (*(volatile size_t*)(ptr))
+#define CHUNKED_LIST_ATOMIC_STORE_SIZE(ptr, value) (*(volatile size_t*)(ptr) = (value))
+#define CHUNKED_LIST_ATOMIC_CAS(ptr, expected, desired) \
+    (_InterlockedCompareExchange((volatile long*)(ptr), (desired), (expected)) == (expected))
+#define CHUNKED_LIST_ATOMIC_CAS_PTR(ptr, expected, desired) \
+    (_InterlockedCompareExchangePointer((void* volatile*)(ptr), (desired), (expected)) == (void*)(expected))
+#define CHUNKED_LIST_ATOMIC_FENCE() _mm_mfence()
+#else
+#define CHUNKED_LIST_ATOMIC_LOAD_PTR(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define CHUNKED_LIST_ATOMIC_STORE_PTR(ptr, value) __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+#define CHUNKED_LIST_ATOMIC_LOAD_SIZE(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define CHUNKED_LIST_ATOMIC_STORE_SIZE(ptr, value) __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+#define CHUNKED_LIST_ATOMIC_CAS(ptr, expected, desired) __sync_bool_compare_and_swap((ptr), (expected), (desired))
+#define CHUNKED_LIST_ATOMIC_CAS_PTR(ptr, expected, desired) __sync_bool_compare_and_swap((ptr), (expected), (desired))
+#define CHUNKED_LIST_ATOMIC_FENCE() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
+
+// Size of a cache line, reader slots are aligned to it so that readers do not share cache lines
+#define CHUNKED_LIST_CACHE_LINE 64
+
+// Hint to load the cache line at addr for reading, without effect where the compiler offers no prefetch
+// or if CHUNKED_LIST_NO_PREFETCH is defined
+#if defined(CHUNKED_LIST_NO_PREFETCH)
+#define CHUNKED_LIST_PREFETCH(addr) ((void)(addr))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define CHUNKED_LIST_PREFETCH(addr) _mm_prefetch((const char*)(addr), _MM_HINT_T0)
+#elif defined(__GNUC__)
+#define CHUNKED_LIST_PREFETCH(addr) __builtin_prefetch((addr), 0, 3)
+#else
+#define CHUNKED_LIST_PREFETCH(addr) ((void)(addr))
+#endif
+
+// Block of memory holding several chunks, freed when its last chunk is destroyed
+typedef struct {
+    long live_chunks;  // Number of chunks of the slab not destroyed yet
+    int node;          // NUMA node holding the slab
+    size_t numa_size;  // Size of the slab if it was allocated by libnuma, 0 if by malloc
+} ChunkSlab;
+
 typedef struct Chunk {
     struct Chunk* next;
-    size_t used;  // Number of bytes used in this chunk
-    char data[];  // Flexible array member to hold items
+    ChunkSlab* slab;       // Slab the chunk was carved from, NULL if allocated on its own
+    struct Chunk* source;  // Chunk owning the items if they are borrowed by a snapshot, NULL otherwise
+    long refcount;         // References to this chunk: its list and every chunk borrowing its items
+    size_t capacity;       // Number of bytes available for items
+    size_t used;           // Number of bytes used in this chunk
+    size_t item_count;     // Number of items, only maintained in variable-length and slot-map mode
+    size_t key_count;      // Number of leading items folded into key_min/key_max
+    int64_t key_min;       // Smallest key of the summarized items
+    int64_t key_max;       // Largest key of the summarized items
+    size_t compressed_size; // Number of encoded bytes in data if the chunk is compressed, 0 otherwise
+    size_t last_access;    // Value of the list's sweep_count when the items were last accessed
+    int node;              // NUMA node holding the items
+    size_t slot_base;      // Number of the first slot of the chunk in slot-map mode
+    char* data;            // Items of the chunk, points to payload unless they are borrowed
+    char payload[];        // Flexible array member to hold items
 } Chunk;
 
+// Non-zero if a chunk's items may be modified in place without affecting a snapshot
+#define CHUNK_IS_EXCLUSIVE(chunk) (!(chunk)->source && CHUNKED_LIST_ATOMIC_LOAD(&(chunk)->refcount) == 1)
+
+// Registration of a reader of a reader-safe list
+typedef struct ReaderSlot {
+    size_t epoch;                 // Epoch of the list when the reader entered its read section, 0 outside of it
+    long in_use;                  // Non-zero while the slot is registered
+    struct ReaderSlot* next;      // Next slot of the list, slots are only freed with the list
+    const size_t* list_epoch;     // Epoch counter of the list
+    void* allocation;             // Start of the allocation holding the aligned slot
+} ReaderSlot;
+
+// Chunk unlinked from a reader-safe list, freed once no reader may still hold it
+typedef struct {
+    Chunk* chunk;
+    size_t epoch;  // Epoch of the list when the chunk was unlinked
+} RetiredChunk;
+
+typedef struct {
+    Chunk* chunk;        // A non-empty chunk
+    size_t first_index;  // Global index of the first item in the chunk
+} ChunkIndexEntry;
+
+#ifdef CHUNKED_LIST_ENABLE_STATS
 typedef struct {
-    size_t item_size;    // Size of each item
+    size_t add_count;
+    size_t expand_count;
+    size_t insert_count;
+    size_t at_count;
+    size_t remove_count;
+    size_t clear_count;
+    size_t search_count;
+    size_t scan_count;
+    size_t scan_chunks_skipped;
+    size_t chunk_allocations;
+    size_t at_chunks_walked;
+    size_t compress_count;
+    size_t decompress_count;
+    uint64_t decompress_ns;
+} ChunkedListCounters;
+
+// Increment an operation counter, compiled out unless CHUNKED_LIST_ENABLE_STATS is defined
+#define CHUNKED_LIST_STAT_ADD(chunked_list, counter, value) ((chunked_list)->counters.counter += (value))
+#else
+#define CHUNKED_LIST_STAT_ADD(chunked_list, counter, value) ((void)0)
+#endif
+
+#define CHUNKED_LIST_STAT_INC(chunked_list, counter) CHUNKED_LIST_STAT_ADD(chunked_list, counter, 1)
+
+// Increment a counter of an operation readers may call, reader-safe lists do not count it since readers never write to the list
+#define CHUNKED_LIST_READ_STAT_INC(chunked_list, counter) \
+    (CHUNKED_LIST_IS_READER_SAFE(chunked_list) ? (void)0 : (void)CHUNKED_LIST_STAT_INC(chunked_list, counter))
+
+typedef struct {
+    unsigned flags;      // CHUNKED_LIST_FLAG_* the list was created with
+    size_t item_size;    // Size of each item, 0 in variable-length mode
 	size_t chunk_size;	 // Size of each chunk
     size_t total_items;  // Total number of items in the chunked_list
     Chunk* head;         // Pointer to the first chunk
     Chunk* tail;         // Pointer to the last chunk
+    Chunk* spare;        // Pre-allocated empty chunks used by appends before allocating new ones
+    size_t spare_count;  // Number of chunks in the spare chain
+    CHUNKED_LIST_KEY_EXTRACTOR key_extractor; // Key callback for chunk summaries, NULL if disabled
+    ChunkIndexEntry* chunk_index;   // Non-empty chunks in list order, used for binary searches
+    size_t chunk_index_count;       // Number of valid entries in chunk_index
+    size_t chunk_index_capacity;    // Number of allocated entries in chunk_index
+    int chunk_index_valid;          // Non-zero if chunk_index reflects the current chain
+    size_t sweep_count;             // Logical clock advanced by every chunked_list_compress_cold call
+    size_t epoch;                   // Reclamation epoch, advanced whenever a chunk is retired
+    ReaderSlot* readers;            // Registered reader slots of a reader-safe list
+    RetiredChunk* retired;          // Unlinked chunks waiting for readers to leave
+    size_t retired_count;           // Number of entries in retired
+    size_t retired_capacity;        // Number of allocated entries in retired
+    int numa_policy;                // CHUNKED_LIST_NUMA_* placement of new chunks
+    int numa_node;                  // Node of CHUNKED_LIST_NUMA_BIND, next node of CHUNKED_LIST_NUMA_INTERLEAVE
+    size_t numa_refill;             // Number of chunks added by the last refill of the spare chain, 0 before the first
+    size_t slots_per_chunk;         // Number of item slots of a chunk in slot-map mode
+    size_t slot_header_size;        // Bytes of occupancy bitmap and generations in front of the items of a slot-map chunk
+    Chunk** slot_chunks;            // Chunks of a slot-map list by slot_base / slots_per_chunk
+    size_t slot_chunk_count;        // Number of chunks in slot_chunks
+    size_t slot_chunk_capacity;     // Number of allocated entries in slot_chunks
+    size_t* free_slots;             // Stack of the numbers of free slots
+    size_t free_slot_count;         // Number of entries in free_slots
+    size_t free_slot_capacity;      // Number of allocated entries in free_slots
+    uint32_t slot_generation;       // Generation of the slots of new chunks, advanced by chunked_list_clear
+#ifdef CHUNKED_LIST_ENABLE_STATS
+    ChunkedListCounters counters;   // Operation counters reported by chunked_list_get_stats
+#endif
 } ChunkedList;
 
+// Non-zero if the list stores items of individual sizes
+#define CHUNKED_LIST_IS_VARIABLE_LENGTH(chunked_list) ((chunked_list)->flags & CHUNKED_LIST_FLAG_VARIABLE_LENGTH)
+
+// Non-zero if the list may be read concurrently with its writer
+#define CHUNKED_LIST_IS_READER_SAFE(chunked_list) ((chunked_list)->flags & CHUNKED_LIST_FLAG_READER_SAFE)
+
+// Non-zero if removed items leave free slots instead of shifting the following items
+#define CHUNKED_LIST_IS_SLOT_MAP(chunked_list) ((chunked_list)->flags & CHUNKED_LIST_FLAG_SLOT_MAP)
+
+// Occupancy bitmap of a slot-map chunk at the start of its payload, bit i is set if slot i holds an item
+#define CHUNK_SLOT_BITMAP(chunk) ((uint64_t*)(chunk)->payload)
+
+// Non-zero if slot pos of a slot-map chunk holds an item
+#define CHUNK_SLOT_OCCUPIED(chunk, pos) ((CHUNK_SLOT_BITMAP(chunk)[(pos) / 64] >> ((pos) % 64)) & 1)
+
+// Create a new empty chunk with room for chunk_size bytes of items
+Chunk* create_chunk(size_t chunk_size);
+
+// Number of bytes of a slab holding chunk_count chunks with room for payload_size bytes of items each
+size_t slab_size(size_t chunk_count, size_t payload_size);
+
+// Allocate a slab holding chunk_count chunks with room for payload_size bytes of items each
+ChunkSlab* create_slab(size_t chunk_count, size_t payload_size);
+
+// Allocate a slab of chunk_count chunks whose pages are placed on node if NUMA placement is enabled
+ChunkSlab* create_node_slab(size_t chunk_count, size_t payload_size, int node);
+
+// Initialize and get the chunk at idx of a slab created with the same payload_size
+Chunk* slab_chunk(ChunkSlab* slab, size_t idx, size_t payload_size);
+
+// Free the memory of a slab, allocated by malloc or libnuma
+void free_slab(ChunkSlab* slab);
+
+// NUMA node of the calling thread, 0 if NUMA is not supported or simulated
+int current_numa_node(void);
+
+// Add at least chunk_count chunks placed according to the NUMA policy of the list to its spare chain,
+// carved from one slab per node. Adds nothing if allocation fails
+int reserve_numa_chunks(ChunkedList* chunked_list, size_t chunk_count);
+
+// Add a batch of chunks to the empty spare chain of a list with a NUMA policy, growing with every refill
+int refill_numa_chunks(ChunkedList* chunked_list);
+
+// Release the chunks of the spare chain
+void release_spare_chunks(ChunkedList* chunked_list);
+
+// Drop a reference to a chunk, freeing it (or releasing it from its slab) with the last one
+void destroy_chunk(Chunk* chunk);
+
+// Replace a chunk shared with snapshots by a private copy, returns the copy or NULL if allocation fails
+Chunk* unshare_chunk(ChunkedList* chunked_list, Chunk* chunk);
+
+// Take an empty chunk from the spare chain, or create a new one if there is none
+Chunk* acquire_chunk(ChunkedList* chunked_list);
+
+// Put replacement in the place of chunk in the chain and the chunk index, and drop the reference to chunk.
+// Returns CHUNKED_LIST_ERROR_ALLOCATION_FAILED, leaving the chain as it was, if chunk cannot be retired
+int replace_chunk(ChunkedList* chunked_list, Chunk* chunk, Chunk* replacement);
+
+// Make room for retiring count more chunks of a reader-safe list, so that retire_chunk cannot fail
+int reserve_retired(ChunkedList* chunked_list, size_t count);
+
+// Drop the reference to an unlinked chunk once no reader of a reader-safe list may hold it,
+// room must have been reserved and the batch ended with end_retire_batch
+void retire_chunk(ChunkedList* chunked_list, Chunk* chunk);
+
+// Advance the epoch past the chunks retired since the last batch and destroy the ones no reader may hold
+void end_retire_batch(ChunkedList* chunked_list);
+
+// Destroy the retired chunks no reader may hold anymore, returns the number of chunks still retired
+size_t reclaim_chunks(ChunkedList* chunked_list);
+
+// Remove the item at chunk_pos of chunk by publishing a copy of the chunk without it
+int remove_by_copy(ChunkedList* chunked_list, Chunk* chunk, size_t chunk_pos);
+
+// Append an item to the end of the list without writing it, returns its address in destination
+int append_item(ChunkedList* chunked_list, void** destination);
+
+// Compute the slot layout of a slot-map list, returns zero if not a single slot fits in a chunk
+int init_slot_layout(ChunkedList* chunked_list);
+
+// Format an empty chunk for a slot-map list and register it for lookups by handle
+int link_slot_chunk(ChunkedList* chunked_list, Chunk* chunk);
+
+// Find the chunk and slot of the item at index of a slot-map list, NULL if index is out of range
+Chunk* locate_slot_item(ChunkedList* chunked_list, size_t index, size_t* chunk_pos);
+
+// First occupied slot at or after pos of a slot-map chunk, or the number of used slots if there is none
+size_t next_occupied_slot(const ChunkedList* chunked_list, const Chunk* chunk, size_t pos);
+
+// Free the slot pos of a slot-map chunk
+int free_slot(ChunkedList* chunked_list, Chunk* chunk, size_t pos);
+
+// Handle of the item in slot pos of a slot-map chunk
+uint64_t slot_handle(const ChunkedList* chunked_list, const Chunk* chunk, size_t pos);
+
+// Forget all slots before the chunks of a slot-map list are destroyed, so that their handles stay invalid
+void reset_slots(ChunkedList* chunked_list);
+
+// Mark a chunk as accessed before reading its items, decompressing it if necessary.
+// Returns the chunk now holding the items, or NULL if allocation fails
+Chunk* touch_chunk(ChunkedList* chunked_list, Chunk* chunk);
+
+// First item of a non-empty chunk without decompressing it: the items of a plain chunk, or the first
+// item of a compressed one decoded into buffer, which must hold item_size bytes
+const char* chunk_first_item(const ChunkedList* chunked_list, const Chunk* chunk, char* buffer);
+
+// Offset table of a variable-length chunk, growing downwards from the end of the chunk:
+// entry [-1 - i] holds the offset of item i, which ends where item i + 1 (or the used bytes) starts
+uint32_t* chunk_offsets(const Chunk* chunk);
+
+// Address and length of the item at chunk_pos of a variable-length chunk
+char* chunk_bytes_item(const Chunk* chunk, size_t chunk_pos, size_t* length);
+
+// Remove the item at index of a variable-length list
+int remove_bytes_item(ChunkedList* chunked_list, size_t index);
+
+// Fold the items of a chunk that are not yet summarized into its key_min/key_max, the chunk must not be compressed
+void update_chunk_summary(ChunkedList* chunked_list, Chunk* chunk);
+
+// Update the summary of a chunk before the item at chunk_pos is removed from it
+void remove_from_chunk_summary(ChunkedList* chunked_list, Chunk* chunk, size_t chunk_pos);
+
+// Rebuild the chunk index if a structural change invalidated it
+int update_chunk_index(ChunkedList* chunked_list);
+
 #endif // CHUNKED_LIST_IMP_H
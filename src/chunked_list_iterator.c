@@ -1,5 +1,7 @@
 #include <stdlib.h>
 #include "chunked_list_iterator.h"
+#include "chunked_list_bytes.h"
+#include "chunked_list_slots.h"
 #include "chunked_list_imp.h"
 
 // Internal iterator structure, hidden from the user
@@ -10,6 +12,57 @@ typedef struct {
     size_t global_index;       // The global position in the entire list
 } ChunkListIterator;
 
+// Number of items in a chunk of the iterated list, the writer of a reader-safe list may append concurrently
+static size_t chunk_items(const ChunkedList* chunked_list, const Chunk* chunk) {
+    return CHUNKED_LIST_IS_VARIABLE_LENGTH(chunked_list) || CHUNKED_LIST_IS_SLOT_MAP(chunked_list)
+        ? chunk->item_count
+        : CHUNKED_LIST_ATOMIC_LOAD_SIZE(&chunk->used) / chunked_list->item_size;
+}
+
+// Advance to the first non-empty chunk starting at chunk, removals may leave empty chunks behind
+static Chunk* skip_empty_chunks(const ChunkedList* chunked_list, Chunk* chunk) {
+    while (chunk && chunk_items(chunked_list, chunk) == 0) {
+        chunk = CHUNKED_LIST_ATOMIC_LOAD_PTR(&chunk->next);
+    }
+    return chunk;
+}
+
+// Number of cache lines of the next chunk's items loaded ahead, the hardware prefetcher follows
+// the sequential accesses within a chunk from there
+#define PREFETCH_ITEM_LINES 2
+
+// Start loading the chunks after chunk while its items are visited: the items of the next chunk, and
+// the header of the one after it, which was loaded ahead when chunk was entered
+static void prefetch_chunks(Chunk* chunk) {
+    Chunk* next = CHUNKED_LIST_ATOMIC_LOAD_PTR(&chunk->next);
+    if (!next) {
+        return;
+    }
+    for (size_t line = 0; line < PREFETCH_ITEM_LINES; ++line) {
+        CHUNKED_LIST_PREFETCH(next->data + line * CHUNKED_LIST_CACHE_LINE);
+    }
+    Chunk* after = CHUNKED_LIST_ATOMIC_LOAD_PTR(&next->next);
+    if (after) {
+        CHUNKED_LIST_PREFETCH(after);
+        CHUNKED_LIST_PREFETCH((char*)after + CHUNKED_LIST_CACHE_LINE);
+    }
+}
+
+// Make the first non-empty chunk starting at chunk the current one, decompressing it if necessary.
+// Returns zero if allocation fails
+static int enter_chunk(ChunkListIterator* iterator, Chunk* chunk) {
+    chunk = skip_empty_chunks(iterator->list, chunk);
+    iterator->current_chunk = chunk ? touch_chunk(iterator->list, chunk) : NULL;
+    iterator->chunk_pos = 0;
+    if (iterator->current_chunk) {
+        prefetch_chunks(iterator->current_chunk);
+        if (CHUNKED_LIST_IS_SLOT_MAP(iterator->list)) {
+            iterator->chunk_pos = next_occupied_slot(iterator->list, iterator->current_chunk, 0);
+        }
+    }
+    return chunk == NULL || iterator->current_chunk != NULL;
+}
+
 CHUNKED_LIST_ITERATOR_HANDLE chunked_list_iterator_create(CHUNKED_LIST_HANDLE list) {
     ChunkListIterator* iterator = (ChunkListIterator*)malloc(sizeof(ChunkListIterator));
     if (!iterator) {
@@ -18,9 +71,11 @@ CHUNKED_LIST_ITERATOR_HANDLE chunked_list_iterator_create(CHUNKED_LIST_HANDLE li
 
     ChunkedList* chunked_list = (ChunkedList*)list;
     iterator->list = chunked_list;
-    iterator->current_chunk = chunked_list->head;
-    iterator->chunk_pos = 0;
     iterator->global_index = 0;
+    if (!enter_chunk(iterator, CHUNKED_LIST_ATOMIC_LOAD_PTR(&chunked_list->head))) {
+        free(iterator);
+        return NULL;
+    }
 
     return iterator;
 }
@@ -35,28 +90,67 @@ void chunked_list_iterator_destroy(CHUNKED_LIST_ITERATOR_HANDLE iterator_handle)
 int chunked_list_iterator_get(CHUNKED_LIST_ITERATOR_HANDLE iterator_handle, void** item) {
     ChunkListIterator* iterator = (ChunkListIterator*)iterator_handle;
 
-    if (!iterator->current_chunk || iterator->global_index >= iterator->list->total_items) {
+    if (!iterator->current_chunk) {
         return CHUNKED_LIST_ITERATOR_ERROR_INVALID_INDEX;  // Out of bounds
     }
 
-    *item = (void*)(iterator->current_chunk->data + iterator->chunk_pos * iterator->list->item_size);
+    if (CHUNKED_LIST_IS_VARIABLE_LENGTH(iterator->list)) {
+        *item = chunk_bytes_item(iterator->current_chunk, iterator->chunk_pos, NULL);
+    } else {
+        *item = (void*)(iterator->current_chunk->data + iterator->chunk_pos * iterator->list->item_size);
+    }
+    return CHUNKED_LIST_ITERATOR_SUCCESS;
+}
+
+int chunked_list_iterator_get_bytes(CHUNKED_LIST_ITERATOR_HANDLE iterator_handle, void** item, size_t* length) {
+    ChunkListIterator* iterator = (ChunkListIterator*)iterator_handle;
+
+    if (!CHUNKED_LIST_IS_VARIABLE_LENGTH(iterator->list)) {
+        return CHUNKED_LIST_ITERATOR_ERROR_INVALID_OPERATION;
+    }
+    if (!iterator->current_chunk) {
+        return CHUNKED_LIST_ITERATOR_ERROR_INVALID_INDEX;  // Out of bounds
+    }
+
+    *item = chunk_bytes_item(iterator->current_chunk, iterator->chunk_pos, length);
+    return CHUNKED_LIST_ITERATOR_SUCCESS;
+}
+
+int chunked_list_iterator_get_slot(CHUNKED_LIST_ITERATOR_HANDLE iterator_handle, CHUNKED_LIST_SLOT_HANDLE* handle) {
+    ChunkListIterator* iterator = (ChunkListIterator*)iterator_handle;
+
+    if (!CHUNKED_LIST_IS_SLOT_MAP(iterator->list)) {
+        return CHUNKED_LIST_ITERATOR_ERROR_INVALID_OPERATION;
+    }
+    if (!iterator->current_chunk) {
+        return CHUNKED_LIST_ITERATOR_ERROR_INVALID_INDEX;  // Out of bounds
+    }
+
+    *handle = slot_handle(iterator->list, iterator->current_chunk, iterator->chunk_pos);
     return CHUNKED_LIST_ITERATOR_SUCCESS;
 }
 
 int chunked_list_iterator_next(CHUNKED_LIST_ITERATOR_HANDLE iterator_handle) {
     ChunkListIterator* iterator = (ChunkListIterator*)iterator_handle;
 
-    if (!iterator->current_chunk || iterator->global_index >= iterator->list->total_items) {
+    if (!iterator->current_chunk) {
         return CHUNKED_LIST_ITERATOR_ERROR_INVALID_INDEX;  // No more items
     }
 
     iterator->chunk_pos++;
-    size_t items_in_current_chunk = iterator->current_chunk->used / iterator->list->item_size;
+    size_t items_in_current_chunk;
+    if (CHUNKED_LIST_IS_SLOT_MAP(iterator->list)) {
+        // Skip free slots, the position runs over all used slots of the chunk
+        iterator->chunk_pos = next_occupied_slot(iterator->list, iterator->current_chunk, iterator->chunk_pos);
+        items_in_current_chunk = iterator->current_chunk->used / iterator->list->item_size;
+    } else {
+        items_in_current_chunk = chunk_items(iterator->list, iterator->current_chunk);
+    }
 
     // Move to the next chunk if necessary
-    if (iterator->chunk_pos >= items_in_current_chunk) {
-        iterator->current_chunk = iterator->current_chunk->next;
-        iterator->chunk_pos = 0;
+    if (iterator->chunk_pos >= items_in_current_chunk &&
+        !enter_chunk(iterator, CHUNKED_LIST_ATOMIC_LOAD_PTR(&iterator->current_chunk->next))) {
+        return CHUNKED_LIST_ITERATOR_ERROR_ALLOCATION_FAILED;
     }
 
     iterator->global_index++;
@@ -65,7 +159,8 @@ int chunked_list_iterator_next(CHUNKED_LIST_ITERATOR_HANDLE iterator_handle) {
 
 int chunked_list_iterator_is_end(CHUNKED_LIST_ITERATOR_HANDLE iterator_handle) {
     ChunkListIterator* iterator = (ChunkListIterator*)iterator_handle;
-    return (iterator->global_index >= iterator->list->total_items) ? 1 : 0;
+    // Only non-empty chunks become current, so there is an item as long as there is a chunk
+    return iterator->current_chunk ? 0 : 1;
 }
 
 size_t chunked_list_iterator_get_index(CHUNKED_LIST_ITERATOR_HANDLE iterator_handle)
@@ -0,0 +1,178 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "chunked_list_layout.h"
+#include "chunked_list_imp.h"
+
+// Chunks of the chain and what takes their place after the relayout
+typedef struct {
+    Chunk* chunk;
+    Chunk* replacement;  // Copy in a slab, the chunk itself if it stays, NULL if it is dropped
+} ChainEntry;
+
+// Consecutive movable chunks on the same node, copied into one slab
+typedef struct {
+    ChunkSlab* slab;
+    size_t chunk_count;
+    int node;
+} SlabRun;
+
+// Non-zero if the items of a chunk may be moved to a slab chunk, whose payload holds chunk_size bytes.
+// Oversized variable-length chunks do not fit and stay where they are
+static int is_movable(const ChunkedList* chunked_list, const Chunk* chunk) {
+    size_t payload_size = (size_t)(chunk->data - chunk->payload) + chunk->capacity;
+    return !chunk->compressed_size && payload_size <= chunked_list->chunk_size && CHUNK_IS_EXCLUSIVE(chunk);
+}
+
+// Non-zero if a chunk holds nothing worth keeping
+static int is_droppable(const ChunkedList* chunked_list, const Chunk* chunk) {
+    return chunk->used == 0 && !CHUNKED_LIST_IS_SLOT_MAP(chunked_list); // Slot-map chunks own their slot numbers
+}
+
+// Copy the items of chunk into the empty chunk copy, with the bookkeeping of all modes
+static void copy_chunk(ChunkedList* chunked_list, Chunk* copy, const Chunk* chunk) {
+    size_t header = (size_t)(chunk->data - chunk->payload); // Occupancy bitmap and generations of a slot map
+    memcpy(copy->payload, chunk->payload, header + chunk->used);
+    copy->data = copy->payload + header;
+    copy->capacity = chunk->capacity;
+    copy->used = chunk->used;
+    copy->item_count = chunk->item_count;
+    if (CHUNKED_LIST_IS_VARIABLE_LENGTH(chunked_list) && chunk->item_count) {
+        memcpy(chunk_offsets(copy) - chunk->item_count, chunk_offsets(chunk) - chunk->item_count, chunk->item_count * sizeof(uint32_t));
+    }
+    copy->key_count = chunk->key_count;
+    copy->key_min = chunk->key_min;
+    copy->key_max = chunk->key_max;
+    copy->last_access = chunk->last_access;
+    copy->slot_base = chunk->slot_base;
+    if (CHUNKED_LIST_IS_SLOT_MAP(chunked_list)) {
+        chunked_list->slot_chunks[chunk->slot_base / chunked_list->slots_per_chunk] = copy;
+    }
+}
+
+int chunked_list_relayout(CHUNKED_LIST_HANDLE list, size_t* relocated_chunks) {
+    ChunkedList* chunked_list = (ChunkedList*)list;
+    if (relocated_chunks) {
+        *relocated_chunks = 0;
+    }
+
+    // Count the chunks and the runs of movable chunks, a run ends where the node changes
+    size_t chunk_count = 0;
+    size_t run_count = 0;
+    int run_node = -1;
+    for (Chunk* current = chunked_list->head; current; current = current->next) {
+        chunk_count++;
+        if (!is_droppable(chunked_list, current) && is_movable(chunked_list, current) && current->node != run_node) {
+            run_node = current->node;
+            run_count++;
+        }
+    }
+    if (!chunk_count) {
+        return CHUNKED_LIST_SUCCESS;
+    }
+
+    ChainEntry* entries = (ChainEntry*)malloc(chunk_count * sizeof(ChainEntry));
+    SlabRun* runs = (SlabRun*)calloc(run_count ? run_count : 1, sizeof(SlabRun));
+    if (!entries || !runs) {
+        free(entries);
+        free(runs);
+        return CHUNKED_LIST_ERROR_ALLOCATION_FAILED;
+    }
+
+    size_t idx = 0;
+    SlabRun* run = NULL;
+    for (Chunk* current = chunked_list->head; current; current = current->next) {
+        entries[idx++].chunk = current;
+        if (!is_droppable(chunked_list, current) && is_movable(chunked_list, current)) {
+            if (!run || run->node != current->node) {
+                run = run ? run + 1 : runs;
+                run->node = current->node;
+            }
+            run->chunk_count++;
+        }
+    }
+
+    // Allocate all slabs and room to retire the old chunks before touching the chain, so that a
+    // failure leaves the list as it was
+    if (reserve_retired(chunked_list, chunk_count) != CHUNKED_LIST_SUCCESS) {
+        free(entries);
+        free(runs);
+        return CHUNKED_LIST_ERROR_ALLOCATION_FAILED;
+    }
+    for (size_t run_idx = 0; run_idx < run_count; ++run_idx) {
+        runs[run_idx].slab = create_node_slab(runs[run_idx].chunk_count, chunked_list->chunk_size, runs[run_idx].node);
+        if (!runs[run_idx].slab) {
+            while (run_idx > 0) {
+                free_slab(runs[--run_idx].slab);
+            }
+            free(entries);
+            free(runs);
+            return CHUNKED_LIST_ERROR_ALLOCATION_FAILED;
+        }
+        CHUNKED_LIST_STAT_INC(chunked_list, chunk_allocations);
+    }
+
+    // Copy the movable chunks in list order, so addresses ascend along the chain within a slab
+    size_t moved = 0;
+    size_t slab_pos = 0;
+    run = NULL;
+    for (idx = 0; idx < chunk_count; ++idx) {
+        Chunk* chunk = entries[idx].chunk;
+        if (is_droppable(chunked_list, chunk)) {
+            entries[idx].replacement = NULL;
+        } else if (!is_movable(chunked_list, chunk)) {
+            entries[idx].replacement = chunk;
+        } else {
+            if (!run || slab_pos == run->chunk_count) {
+                run = run ? run + 1 : runs;
+                slab_pos = 0;
+            }
+            Chunk* copy = slab_chunk(run->slab, slab_pos++, chunked_list->chunk_size);
+            copy_chunk(chunked_list, copy, chunk);
+            entries[idx].replacement = copy;
+            moved++;
+        }
+    }
+
+    // Link back to front, so that a reader following any published link finds a complete chain
+    Chunk* next = NULL;
+    Chunk* tail = NULL;
+    for (idx = chunk_count; idx > 0; --idx) {
+        Chunk* replacement = entries[idx - 1].replacement;
+        if (!replacement) {
+            continue;
+        }
+        tail = tail ? tail : replacement;
+        if (replacement == entries[idx - 1].chunk) {
+            CHUNKED_LIST_ATOMIC_STORE_PTR(&replacement->next, next);
+        } else {
+            replacement->next = next;
+        }
+        next = replacement;
+    }
+    CHUNKED_LIST_ATOMIC_STORE_PTR(&chunked_list->head, next);
+    chunked_list->tail = tail;
+    chunked_list->chunk_index_valid = 0;
+
+    // Readers may still be inside the old chunks
+    for (idx = 0; idx < chunk_count; ++idx) {
+        if (entries[idx].replacement == entries[idx].chunk) {
+            continue;
+        }
+        if (CHUNKED_LIST_IS_READER_SAFE(chunked_list)) {
+            retire_chunk(chunked_list, entries[idx].chunk);
+        } else {
+            destroy_chunk(entries[idx].chunk);
+        }
+    }
+    if (CHUNKED_LIST_IS_READER_SAFE(chunked_list)) {
+        end_retire_batch(chunked_list);
+    }
+
+    free(entries);
+    free(runs);
+    if (relocated_chunks) {
+        *relocated_chunks = moved;
+    }
+    return CHUNKED_LIST_SUCCESS;
+}
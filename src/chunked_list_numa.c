@@ -0,0 +1,384 @@
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // sched_getcpu
+#endif
+#include <stdlib.h>
+#include <string.h>
+#if defined(_WIN32)
+#include <windows.h>
+#include <process.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+#ifdef CHUNKED_LIST_ENABLE_NUMA
+#include <numa.h>
+#endif
+
+#include "chunked_list_numa.h"
+#include "chunked_list_imp.h"
+
+// Upper bound of the chunk bytes per node added by one refill of the spare chain
+#define NUMA_REFILL_MAX_BYTES (1024 * 1024)
+
+static int simulated_node_count; // 0 unless a topology is simulated
+static long real_node_count;     // 0 until the real topology was probed
+
+void chunked_list_numa_simulate(int node_count) {
+    simulated_node_count = node_count > 0 ? node_count : 0;
+}
+
+#ifdef CHUNKED_LIST_ENABLE_NUMA
+// Non-zero if chunks are actually placed with libnuma
+static int numa_enabled(void) {
+    return !simulated_node_count && chunked_list_numa_node_count() > 1;
+}
+#endif
+
+int chunked_list_numa_node_count(void) {
+    if (simulated_node_count) {
+        return simulated_node_count;
+    }
+    long node_count = CHUNKED_LIST_ATOMIC_LOAD(&real_node_count);
+    if (!node_count) {
+        node_count = 1;
+#ifdef CHUNKED_LIST_ENABLE_NUMA
+        if (numa_available() >= 0) {
+            node_count = numa_max_node() + 1;
+        }
+#endif
+        CHUNKED_LIST_ATOMIC_CAS(&real_node_count, 0, node_count);
+    }
+    return (int)node_count;
+}
+
+int current_numa_node(void) {
+#ifdef CHUNKED_LIST_ENABLE_NUMA
+    if (numa_enabled()) {
+        int cpu = sched_getcpu();
+        int node = cpu >= 0 ? numa_node_of_cpu(cpu) : 0;
+        return node >= 0 ? node : 0;
+    }
+#endif
+    return 0;
+}
+
+int chunked_list_set_numa_policy(CHUNKED_LIST_HANDLE list, int policy, int node) {
+    ChunkedList* chunked_list = (ChunkedList*)list;
+    switch (policy) {
+    case CHUNKED_LIST_NUMA_LOCAL:
+    case CHUNKED_LIST_NUMA_INTERLEAVE:
+        node = 0;
+        break;
+    case CHUNKED_LIST_NUMA_BIND:
+        if (node < 0 || node >= chunked_list_numa_node_count()) {
+            return CHUNKED_LIST_ERROR_INVALID_INDEX;
+        }
+        break;
+    default:
+        return CHUNKED_LIST_ERROR_INVALID_OPERATION;
+    }
+    // Spare chunks were placed by the previous policy
+    release_spare_chunks(chunked_list);
+    chunked_list->numa_policy = policy;
+    chunked_list->numa_node = node;
+    chunked_list->numa_refill = 0;
+    return CHUNKED_LIST_SUCCESS;
+}
+
+static size_t page_size(void) {
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwPageSize;
+#else
+    long size = sysconf(_SC_PAGESIZE);
+    return size > 0 ? (size_t)size : 4096;
+#endif
+}
+
+// Allocate a slab of chunk_count chunks whose pages are placed on node
+ChunkSlab* create_node_slab(size_t chunk_count, size_t payload_size, int node) {
+    size_t size = slab_size(chunk_count, payload_size);
+    ChunkSlab* slab;
+#ifdef CHUNKED_LIST_ENABLE_NUMA
+    if (numa_enabled()) {
+        // Fresh pages, so that the first touch cannot place them on another node
+        slab = (ChunkSlab*)numa_alloc_onnode(size, node);
+        if (!slab) {
+            return NULL;
+        }
+        slab->numa_size = size;
+    } else
+#endif
+    {
+        slab = (ChunkSlab*)malloc(size);
+        if (!slab) {
+            return NULL;
+        }
+        slab->numa_size = 0;
+    }
+    slab->live_chunks = (long)chunk_count;
+    slab->node = node;
+    return slab;
+}
+
+void free_slab(ChunkSlab* slab) {
+#ifdef CHUNKED_LIST_ENABLE_NUMA
+    if (slab->numa_size) {
+        numa_free(slab, slab->numa_size);
+        return;
+    }
+#endif
+    free(slab);
+}
+
+int reserve_numa_chunks(ChunkedList* chunked_list, size_t chunk_count) {
+    if (!chunk_count) {
+        return CHUNKED_LIST_SUCCESS;
+    }
+
+    // Pages are the unit of placement, chunks sharing a page share its node
+    size_t unit = 1;
+    while (slab_size(unit, chunked_list->chunk_size) < page_size()) {
+        unit++;
+    }
+    size_t unit_count = (chunk_count + unit - 1) / unit;
+
+    // One slab per node, an interleaved list deals the units round-robin starting at the node in turn
+    int interleave = chunked_list->numa_policy == CHUNKED_LIST_NUMA_INTERLEAVE;
+    size_t node_count = interleave ? (size_t)chunked_list_numa_node_count() : 1;
+    size_t slab_count = node_count < unit_count ? node_count : unit_count;
+    ChunkSlab** slabs = (ChunkSlab**)malloc(slab_count * sizeof(ChunkSlab*));
+    if (!slabs) {
+        return CHUNKED_LIST_ERROR_ALLOCATION_FAILED;
+    }
+    for (size_t turn = 0; turn < slab_count; ++turn) {
+        size_t units = unit_count / slab_count + (turn < unit_count % slab_count ? 1 : 0);
+        int node = interleave ? (int)((chunked_list->numa_node + turn) % node_count) : chunked_list->numa_node;
+        slabs[turn] = create_node_slab(units * unit, chunked_list->chunk_size, node);
+        if (!slabs[turn]) {
+            while (turn > 0) {
+                free_slab(slabs[--turn]);
+            }
+            free(slabs);
+            return CHUNKED_LIST_ERROR_ALLOCATION_FAILED;
+        }
+        CHUNKED_LIST_STAT_INC(chunked_list, chunk_allocations);
+    }
+
+    // Chain the units in the order the policy places them, in front of the existing spare chunks
+    Chunk* first = NULL;
+    Chunk** link = &first;
+    for (size_t dealt = 0; dealt < unit_count; ++dealt) {
+        ChunkSlab* slab = slabs[dealt % slab_count];
+        for (size_t idx = 0; idx < unit; ++idx) {
+            *link = slab_chunk(slab, dealt / slab_count * unit + idx, chunked_list->chunk_size);
+            link = &(*link)->next;
+        }
+    }
+    *link = chunked_list->spare;
+    chunked_list->spare = first;
+    chunked_list->spare_count += unit_count * unit;
+    if (interleave) {
+        chunked_list->numa_node = (int)((chunked_list->numa_node + unit_count) % node_count);
+    }
+    free(slabs);
+    return CHUNKED_LIST_SUCCESS;
+}
+
+int refill_numa_chunks(ChunkedList* chunked_list) {
+    // Double the refill like the growth of an array, so that appends rarely map memory,
+    // but hold at most NUMA_REFILL_MAX_BYTES per node in reserve
+    size_t node_count = chunked_list->numa_policy == CHUNKED_LIST_NUMA_INTERLEAVE ? (size_t)chunked_list_numa_node_count() : 1;
+    size_t limit = node_count * (NUMA_REFILL_MAX_BYTES / chunked_list->chunk_size + 1);
+    chunked_list->numa_refill = chunked_list->numa_refill ? chunked_list->numa_refill * 2 : 1;
+    if (chunked_list->numa_refill > limit) {
+        chunked_list->numa_refill = limit;
+    }
+    return reserve_numa_chunks(chunked_list, chunked_list->numa_refill);
+}
+
+size_t chunked_list_numa_chunks(CHUNKED_LIST_HANDLE list, size_t* chunk_counts, size_t node_count) {
+    ChunkedList* chunked_list = (ChunkedList*)list;
+    memset(chunk_counts, 0, node_count * sizeof(size_t));
+    size_t total = 0;
+    for (Chunk* current = chunked_list->head; current; current = current->next) {
+        if (!current->used) {
+            continue;
+        }
+        if ((size_t)current->node < node_count) {
+            chunk_counts[current->node]++;
+        }
+        total++;
+    }
+    return total;
+}
+
+// Chunks of one node and the state shared by the workers scanning them
+typedef struct {
+    ChunkedList* chunked_list;
+    ChunkIndexEntry* tasks;        // Chunks of the node with the index of their first item
+    size_t task_count;
+    long next_task;                // Number of tasks taken by the workers
+    long* stop;                    // Set when a callback stopped the scan
+    int node;
+    CHUNKED_LIST_SCAN_CALLBACK callback;
+    void* context;
+} NodeScan;
+
+static void scan_node(NodeScan* scan) {
+    size_t item_size = scan->chunked_list->item_size;
+    for (;;) {
+        size_t task = (size_t)CHUNKED_LIST_ATOMIC_INC(&scan->next_task) - 1;
+        if (task >= scan->task_count) {
+            return;
+        }
+
+        const Chunk* chunk = scan->tasks[task].chunk;
+        size_t index = scan->tasks[task].first_index;
+        size_t item_count = chunk->used / item_size;
+        for (size_t pos = 0; pos < item_count; ++pos) {
+            if (CHUNKED_LIST_IS_SLOT_MAP(scan->chunked_list) && !CHUNK_SLOT_OCCUPIED(chunk, pos)) {
+                continue;
+            }
+            if (CHUNKED_LIST_ATOMIC_LOAD(scan->stop)) {
+                return;
+            }
+            if (scan->callback(chunk->data + pos * item_size, index++, scan->context)) {
+                CHUNKED_LIST_ATOMIC_INC(scan->stop);
+                return;
+            }
+        }
+    }
+}
+
+// Worker thread bound to the node of its scan
+#if defined(_WIN32)
+typedef HANDLE WorkerThread;
+
+static unsigned __stdcall worker_main(void* arg) {
+    scan_node((NodeScan*)arg);
+    return 0;
+}
+
+static int start_worker(WorkerThread* thread, NodeScan* scan) {
+    *thread = (HANDLE)_beginthreadex(NULL, 0, worker_main, scan, 0, NULL);
+    return *thread != 0;
+}
+
+static void join_worker(WorkerThread thread) {
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+}
+#else
+typedef pthread_t WorkerThread;
+
+static void* worker_main(void* arg) {
+    NodeScan* scan = (NodeScan*)arg;
+#ifdef CHUNKED_LIST_ENABLE_NUMA
+    if (numa_enabled()) {
+        numa_run_on_node(scan->node);
+    }
+#endif
+    scan_node(scan);
+    return NULL;
+}
+
+static int start_worker(WorkerThread* thread, NodeScan* scan) {
+    return pthread_create(thread, NULL, worker_main, scan) == 0;
+}
+
+static void join_worker(WorkerThread thread) {
+    pthread_join(thread, NULL);
+}
+#endif
+
+int chunked_list_scan_parallel(CHUNKED_LIST_HANDLE list, size_t workers_per_node,
+                               CHUNKED_LIST_SCAN_CALLBACK callback, void* context) {
+    ChunkedList* chunked_list = (ChunkedList*)list;
+    if (CHUNKED_LIST_IS_VARIABLE_LENGTH(chunked_list)) {
+        return CHUNKED_LIST_ERROR_INVALID_OPERATION;
+    }
+    CHUNKED_LIST_STAT_INC(chunked_list, scan_count);
+    workers_per_node = workers_per_node ? workers_per_node : 1;
+    int node_count = chunked_list_numa_node_count();
+
+    // Workers must not modify the chain, so compressed chunks are decompressed up front
+    size_t chunk_count = 0;
+    for (Chunk* current = chunked_list->head; current; current = current->next) {
+        current = touch_chunk(chunked_list, current);
+        if (!current) {
+            return CHUNKED_LIST_ERROR_ALLOCATION_FAILED;
+        }
+        chunk_count += current->used ? 1 : 0;
+    }
+    if (!chunk_count) {
+        return CHUNKED_LIST_SUCCESS;
+    }
+
+    ChunkIndexEntry* tasks = (ChunkIndexEntry*)malloc(chunk_count * sizeof(ChunkIndexEntry));
+    NodeScan* scans = (NodeScan*)calloc((size_t)node_count, sizeof(NodeScan));
+    WorkerThread* threads = (WorkerThread*)malloc((size_t)node_count * workers_per_node * sizeof(WorkerThread));
+    if (!tasks || !scans || !threads) {
+        free(tasks);
+        free(scans);
+        free(threads);
+        return CHUNKED_LIST_ERROR_ALLOCATION_FAILED;
+    }
+
+    // Group the chunks by node, keeping list order within a node
+    for (Chunk* current = chunked_list->head; current; current = current->next) {
+        if (current->used) {
+            scans[current->node % node_count].task_count++;
+        }
+    }
+    size_t offset = 0;
+    long stop = 0;
+    for (int node = 0; node < node_count; ++node) {
+        scans[node].chunked_list = chunked_list;
+        scans[node].tasks = tasks + offset;
+        scans[node].stop = &stop;
+        scans[node].node = node;
+        scans[node].callback = callback;
+        scans[node].context = context;
+        offset += scans[node].task_count;
+        scans[node].task_count = 0;
+    }
+    size_t first_index = 0;
+    for (Chunk* current = chunked_list->head; current; current = current->next) {
+        if (current->used) {
+            NodeScan* scan = &scans[current->node % node_count];
+            ChunkIndexEntry* task = &scan->tasks[scan->task_count++];
+            task->chunk = current;
+            task->first_index = first_index;
+            first_index += CHUNKED_LIST_IS_SLOT_MAP(chunked_list) ? current->item_count
+                                                                  : current->used / chunked_list->item_size;
+        }
+    }
+
+    size_t thread_count = 0;
+    for (int node = 0; node < node_count; ++node) {
+        if (!scans[node].task_count) {
+            continue;
+        }
+        size_t started = 0;
+        for (size_t worker = 0; worker < workers_per_node; ++worker) {
+            if (start_worker(&threads[thread_count], &scans[node])) {
+                thread_count++;
+                started++;
+            }
+        }
+        if (!started) {
+            scan_node(&scans[node]); // No thread available, the caller scans the node itself
+        }
+    }
+    for (size_t idx = 0; idx < thread_count; ++idx) {
+        join_worker(threads[idx]);
+    }
+
+    free(tasks);
+    free(scans);
+    free(threads);
+    return CHUNKED_LIST_SUCCESS;
+}
@@ -0,0 +1,144 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "chunked_list_readers.h"
+#include "chunked_list_imp.h"
+
+CHUNKED_LIST_READER_HANDLE chunked_list_reader_register(CHUNKED_LIST_HANDLE list) {
+    ChunkedList* chunked_list = (ChunkedList*)list;
+    if (!CHUNKED_LIST_IS_READER_SAFE(chunked_list)) {
+        return NULL;
+    }
+
+    // Reuse the slot of an unregistered reader
+    for (ReaderSlot* slot = CHUNKED_LIST_ATOMIC_LOAD_PTR(&chunked_list->readers); slot; slot = slot->next) {
+        if (CHUNKED_LIST_ATOMIC_LOAD(&slot->in_use) == 0 && CHUNKED_LIST_ATOMIC_CAS(&slot->in_use, 0, 1)) {
+            return slot;
+        }
+    }
+
+    void* allocation = malloc(sizeof(ReaderSlot) + 2 * CHUNKED_LIST_CACHE_LINE);
+    if (!allocation) {
+        return NULL;
+    }
+    uintptr_t aligned = ((uintptr_t)allocation + CHUNKED_LIST_CACHE_LINE - 1) & ~(uintptr_t)(CHUNKED_LIST_CACHE_LINE - 1);
+    ReaderSlot* slot = (ReaderSlot*)aligned;
+    slot->epoch = 0;
+    slot->in_use = 1;
+    slot->list_epoch = &chunked_list->epoch;
+    slot->allocation = allocation;
+
+    do {
+        slot->next = CHUNKED_LIST_ATOMIC_LOAD_PTR(&chunked_list->readers);
+    } while (!CHUNKED_LIST_ATOMIC_CAS_PTR(&chunked_list->readers, slot->next, slot));
+    return slot;
+}
+
+void chunked_list_reader_unregister(CHUNKED_LIST_READER_HANDLE reader) {
+    ReaderSlot* slot = (ReaderSlot*)reader;
+    CHUNKED_LIST_ATOMIC_STORE_SIZE(&slot->epoch, 0);
+    CHUNKED_LIST_ATOMIC_CAS(&slot->in_use, 1, 0);
+}
+
+void chunked_list_reader_enter(CHUNKED_LIST_READER_HANDLE reader) {
+    ReaderSlot* slot = (ReaderSlot*)reader;
+    CHUNKED_LIST_ATOMIC_STORE_SIZE(&slot->epoch, CHUNKED_LIST_ATOMIC_LOAD_SIZE(slot->list_epoch));
+    // The writer must see the epoch before this reader loads any chunk pointer
+    CHUNKED_LIST_ATOMIC_FENCE();
+}
+
+void chunked_list_reader_exit(CHUNKED_LIST_READER_HANDLE reader) {
+    ReaderSlot* slot = (ReaderSlot*)reader;
+    CHUNKED_LIST_ATOMIC_STORE_SIZE(&slot->epoch, 0);
+}
+
+// Oldest epoch a reader is in, SIZE_MAX if no reader is in a read section
+static size_t oldest_reader_epoch(ChunkedList* chunked_list) {
+    size_t oldest = SIZE_MAX;
+    for (ReaderSlot* slot = CHUNKED_LIST_ATOMIC_LOAD_PTR(&chunked_list->readers); slot; slot = slot->next) {
+        size_t epoch = CHUNKED_LIST_ATOMIC_LOAD_SIZE(&slot->epoch);
+        if (epoch != 0 && epoch < oldest) {
+            oldest = epoch;
+        }
+    }
+    return oldest;
+}
+
+size_t reclaim_chunks(ChunkedList* chunked_list) {
+    // Readers that entered after a chunk was retired cannot reach it
+    CHUNKED_LIST_ATOMIC_FENCE();
+    size_t oldest = oldest_reader_epoch(chunked_list);
+
+    size_t kept = 0;
+    for (size_t idx = 0; idx < chunked_list->retired_count; ++idx) {
+        if (chunked_list->retired[idx].epoch < oldest) {
+            destroy_chunk(chunked_list->retired[idx].chunk);
+        } else {
+            chunked_list->retired[kept++] = chunked_list->retired[idx];
+        }
+    }
+    chunked_list->retired_count = kept;
+    return kept;
+}
+
+int reserve_retired(ChunkedList* chunked_list, size_t count) {
+    if (!CHUNKED_LIST_IS_READER_SAFE(chunked_list) || chunked_list->retired_count + count <= chunked_list->retired_capacity) {
+        return CHUNKED_LIST_SUCCESS;
+    }
+
+    size_t capacity = chunked_list->retired_capacity ? chunked_list->retired_capacity * 2 : 16;
+    if (capacity < chunked_list->retired_count + count) {
+        capacity = chunked_list->retired_count + count;
+    }
+    RetiredChunk* retired = (RetiredChunk*)realloc(chunked_list->retired, capacity * sizeof(RetiredChunk));
+    if (!retired) {
+        return CHUNKED_LIST_ERROR_ALLOCATION_FAILED;
+    }
+    chunked_list->retired = retired;
+    chunked_list->retired_capacity = capacity;
+    return CHUNKED_LIST_SUCCESS;
+}
+
+void retire_chunk(ChunkedList* chunked_list, Chunk* chunk) {
+    // Readers that entered up to the current epoch may hold the chunk
+    chunked_list->retired[chunked_list->retired_count].chunk = chunk;
+    chunked_list->retired[chunked_list->retired_count].epoch = chunked_list->epoch;
+    chunked_list->retired_count++;
+}
+
+void end_retire_batch(ChunkedList* chunked_list) {
+    CHUNKED_LIST_ATOMIC_STORE_SIZE(&chunked_list->epoch, chunked_list->epoch + 1);
+    reclaim_chunks(chunked_list);
+}
+
+size_t chunked_list_reclaim(CHUNKED_LIST_HANDLE list) {
+    return reclaim_chunks((ChunkedList*)list);
+}
+
+int remove_by_copy(ChunkedList* chunked_list, Chunk* chunk, size_t chunk_pos) {
+    Chunk* copy = acquire_chunk(chunked_list);
+    if (!copy) {
+        return CHUNKED_LIST_ERROR_ALLOCATION_FAILED;
+    }
+
+    size_t offset = chunk_pos * chunked_list->item_size;
+    memcpy(copy->data, chunk->data, offset);
+    memcpy(copy->data + offset, chunk->data + offset + chunked_list->item_size,
+           chunk->used - offset - chunked_list->item_size);
+    copy->used = chunk->used - chunked_list->item_size;
+
+    // Readers do not fold summaries, so the copy gets a complete one before it is published
+    if (chunked_list->key_extractor) {
+        update_chunk_summary(chunked_list, copy);
+    }
+
+    int error_code = replace_chunk(chunked_list, chunk, copy);
+    if (CHUNKED_LIST_SUCCESS != error_code) {
+        destroy_chunk(copy);
+        return error_code;
+    }
+    CHUNKED_LIST_ATOMIC_STORE_SIZE(&chunked_list->total_items, chunked_list->total_items - 1);
+    chunked_list->chunk_index_valid = 0;
+    return CHUNKED_LIST_SUCCESS;
+}
@@ -0,0 +1,99 @@
+#include "chunked_list_scan.h"
+#include "chunked_list_imp.h"
+
+void update_chunk_summary(ChunkedList* chunked_list, Chunk* chunk) {
+    size_t chunk_items = chunk->used / chunked_list->item_size;
+
+    while (chunk->key_count < chunk_items) {
+        int64_t key = chunked_list->key_extractor(chunk->data + chunk->key_count * chunked_list->item_size);
+        if (chunk->key_count == 0 || key < chunk->key_min) {
+            chunk->key_min = key;
+        }
+        if (chunk->key_count == 0 || key > chunk->key_max) {
+            chunk->key_max = key;
+        }
+        chunk->key_count++;
+    }
+}
+
+void remove_from_chunk_summary(ChunkedList* chunked_list, Chunk* chunk, size_t chunk_pos) {
+    if (chunk_pos >= chunk->key_count) {
+        return; // The item is not summarized yet
+    }
+
+    int64_t key = chunked_list->key_extractor(chunk->data + chunk_pos * chunked_list->item_size);
+    if (key == chunk->key_min || key == chunk->key_max) {
+        // The bound may disappear with this item, recompute lazily
+        chunk->key_count = 0;
+    } else {
+        chunk->key_count--;
+    }
+}
+
+int chunked_list_set_key_extractor(CHUNKED_LIST_HANDLE list, CHUNKED_LIST_KEY_EXTRACTOR extractor) {
+    ChunkedList* chunked_list = (ChunkedList*)list;
+    if (CHUNKED_LIST_IS_VARIABLE_LENGTH(chunked_list) || CHUNKED_LIST_IS_SLOT_MAP(chunked_list)) {
+        return CHUNKED_LIST_ERROR_INVALID_OPERATION;
+    }
+
+    chunked_list->key_extractor = extractor;
+    for (Chunk* current = chunked_list->head; current; current = current->next) {
+        current->key_count = 0;
+        if (extractor) {
+            current = touch_chunk(chunked_list, current);
+            if (!current) {
+                chunked_list->key_extractor = NULL;
+                return CHUNKED_LIST_ERROR_ALLOCATION_FAILED;
+            }
+            update_chunk_summary(chunked_list, current);
+        }
+    }
+
+    return CHUNKED_LIST_SUCCESS;
+}
+
+int chunked_list_scan_range(CHUNKED_LIST_HANDLE list, int64_t min_key, int64_t max_key,
+                            CHUNKED_LIST_SCAN_CALLBACK callback, void* context) {
+    ChunkedList* chunked_list = (ChunkedList*)list;
+    if (!chunked_list->key_extractor) {
+        return CHUNKED_LIST_ERROR_INVALID_OPERATION;
+    }
+    CHUNKED_LIST_STAT_INC(chunked_list, scan_count);
+
+    size_t index = 0;
+    for (Chunk* current = chunked_list->head; current; current = current->next) {
+        size_t chunk_items = current->used / chunked_list->item_size;
+        if (chunk_items == 0) {
+            continue;
+        }
+
+        // Summaries are completed lazily, after expand and insert, which hand out items before
+        // they are written. compress_cold completes them first, decompress if one is still missing
+        if (current->key_count < chunk_items) {
+            current = current->compressed_size ? touch_chunk(chunked_list, current) : current;
+            if (!current) {
+                return CHUNKED_LIST_ERROR_ALLOCATION_FAILED;
+            }
+            update_chunk_summary(chunked_list, current);
+        }
+        if (current->key_max < min_key || current->key_min > max_key) {
+            index += chunk_items; // Skip the whole chunk
+            CHUNKED_LIST_STAT_INC(chunked_list, scan_chunks_skipped);
+            continue;
+        }
+
+        current = touch_chunk(chunked_list, current);
+        if (!current) {
+            return CHUNKED_LIST_ERROR_ALLOCATION_FAILED;
+        }
+        for (size_t pos = 0; pos < chunk_items; ++pos, ++index) {
+            void* item = current->data + pos * chunked_list->item_size;
+            int64_t key = chunked_list->key_extractor(item);
+            if (key >= min_key && key <= max_key && callback(item, index, context) != 0) {
+                return CHUNKED_LIST_SUCCESS;
+            }
+        }
+    }
+
+    return CHUNKED_LIST_SUCCESS;
+}
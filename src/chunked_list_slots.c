@@ -0,0 +1,258 @@
+#include <stdlib.h>
+#include <string.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include "chunked_list_slots.h"
+#include "chunked_list_imp.h"
+
+static unsigned popcount64(uint64_t word) {
+#if defined(_MSC_VER)
+    return (unsigned)__popcnt64(word);
+#else
+    return (unsigned)__builtin_popcountll(word);
+#endif
+}
+
+// Position of the lowest set bit, word must not be 0
+static unsigned lowest_bit(uint64_t word) {
+#if defined(_MSC_VER)
+    unsigned long bit;
+    _BitScanForward64(&bit, word);
+    return (unsigned)bit;
+#else
+    return (unsigned)__builtin_ctzll(word);
+#endif
+}
+
+static size_t bitmap_words(size_t slot_count) {
+    return (slot_count + 63) / 64;
+}
+
+// Bytes in front of the items of a chunk, keeps the items aligned like the payload
+static size_t header_size(size_t slot_count) {
+    size_t size = bitmap_words(slot_count) * sizeof(uint64_t) + slot_count * sizeof(uint32_t);
+    return (size + CHUNK_ALIGNMENT - 1) / CHUNK_ALIGNMENT * CHUNK_ALIGNMENT;
+}
+
+// Generation counters of the slots of a chunk, behind the occupancy bitmap
+static uint32_t* chunk_generations(const ChunkedList* chunked_list, const Chunk* chunk) {
+    return (uint32_t*)(chunk->payload + bitmap_words(chunked_list->slots_per_chunk) * sizeof(uint64_t));
+}
+
+int init_slot_layout(ChunkedList* chunked_list) {
+    size_t item_size = chunked_list->item_size;
+    size_t slot_count = chunked_list->chunk_size / (item_size + sizeof(uint32_t));
+    while (slot_count && header_size(slot_count) + slot_count * item_size > chunked_list->chunk_size) {
+        slot_count--;
+    }
+    chunked_list->slots_per_chunk = slot_count;
+    chunked_list->slot_header_size = header_size(slot_count);
+    return slot_count != 0;
+}
+
+int link_slot_chunk(ChunkedList* chunked_list, Chunk* chunk) {
+    // Handles hold 32-bit slot numbers
+    size_t slot_base = chunked_list->slot_chunk_count * chunked_list->slots_per_chunk;
+    if (slot_base + chunked_list->slots_per_chunk - 1 > UINT32_MAX) {
+        return CHUNKED_LIST_ERROR_ALLOCATION_FAILED;
+    }
+    if (chunked_list->slot_chunk_count == chunked_list->slot_chunk_capacity) {
+        size_t capacity = chunked_list->slot_chunk_capacity ? chunked_list->slot_chunk_capacity * 2 : 16;
+        Chunk** slot_chunks = (Chunk**)realloc(chunked_list->slot_chunks, capacity * sizeof(Chunk*));
+        if (!slot_chunks) {
+            return CHUNKED_LIST_ERROR_ALLOCATION_FAILED;
+        }
+        chunked_list->slot_chunks = slot_chunks;
+        chunked_list->slot_chunk_capacity = capacity;
+    }
+    chunked_list->slot_chunks[chunked_list->slot_chunk_count++] = chunk;
+
+    memset(CHUNK_SLOT_BITMAP(chunk), 0, bitmap_words(chunked_list->slots_per_chunk) * sizeof(uint64_t));
+    uint32_t* generations = chunk_generations(chunked_list, chunk);
+    for (size_t pos = 0; pos < chunked_list->slots_per_chunk; ++pos) {
+        generations[pos] = chunked_list->slot_generation;
+    }
+    chunk->data = chunk->payload + chunked_list->slot_header_size;
+    chunk->capacity = chunked_list->slots_per_chunk * chunked_list->item_size;
+    chunk->slot_base = slot_base;
+    return CHUNKED_LIST_SUCCESS;
+}
+
+uint64_t slot_handle(const ChunkedList* chunked_list, const Chunk* chunk, size_t pos) {
+    return ((uint64_t)chunk_generations(chunked_list, chunk)[pos] << 32) | (uint64_t)(chunk->slot_base + pos);
+}
+
+// Chunk and slot of the item a handle refers to, NULL if it was removed or never existed
+static Chunk* resolve_handle(ChunkedList* chunked_list, CHUNKED_LIST_SLOT_HANDLE handle, size_t* chunk_pos) {
+    size_t slot = (size_t)(handle & UINT32_MAX);
+    size_t chunk_number = slot / chunked_list->slots_per_chunk;
+    if (chunk_number >= chunked_list->slot_chunk_count) {
+        return NULL;
+    }
+    Chunk* chunk = chunked_list->slot_chunks[chunk_number];
+    size_t pos = slot % chunked_list->slots_per_chunk;
+    if (pos >= chunk->used / chunked_list->item_size || !CHUNK_SLOT_OCCUPIED(chunk, pos) ||
+        chunk_generations(chunked_list, chunk)[pos] != (uint32_t)(handle >> 32)) {
+        return NULL;
+    }
+    *chunk_pos = pos;
+    return chunk;
+}
+
+Chunk* locate_slot_item(ChunkedList* chunked_list, size_t index, size_t* chunk_pos) {
+    size_t items_to_skip = index;
+    for (Chunk* current = chunked_list->head; current; current = current->next) {
+        CHUNKED_LIST_STAT_INC(chunked_list, at_chunks_walked);
+        if (items_to_skip >= current->item_count) {
+            items_to_skip -= current->item_count;
+            continue;
+        }
+
+        // Count occupied slots word by word, then select the bit within the word
+        const uint64_t* bitmap = CHUNK_SLOT_BITMAP(current);
+        for (size_t word_idx = 0;; ++word_idx) {
+            uint64_t word = bitmap[word_idx];
+            unsigned count = popcount64(word);
+            if (items_to_skip < count) {
+                for (; items_to_skip > 0; --items_to_skip) {
+                    word &= word - 1;
+                }
+                *chunk_pos = word_idx * 64 + lowest_bit(word);
+                return current;
+            }
+            items_to_skip -= count;
+        }
+    }
+    return NULL;
+}
+
+size_t next_occupied_slot(const ChunkedList* chunked_list, const Chunk* chunk, size_t pos) {
+    size_t slot_count = chunk->used / chunked_list->item_size;
+    const uint64_t* bitmap = CHUNK_SLOT_BITMAP(chunk);
+    while (pos < slot_count) {
+        uint64_t word = bitmap[pos / 64] >> (pos % 64);
+        if (word) {
+            pos += lowest_bit(word);
+            return pos < slot_count ? pos : slot_count;
+        }
+        pos = (pos / 64 + 1) * 64;
+    }
+    return slot_count;
+}
+
+int free_slot(ChunkedList* chunked_list, Chunk* chunk, size_t pos) {
+    if (chunked_list->free_slot_count == chunked_list->free_slot_capacity) {
+        size_t capacity = chunked_list->free_slot_capacity ? chunked_list->free_slot_capacity * 2 : 64;
+        size_t* free_slots = (size_t*)realloc(chunked_list->free_slots, capacity * sizeof(size_t));
+        if (!free_slots) {
+            return CHUNKED_LIST_ERROR_ALLOCATION_FAILED;
+        }
+        chunked_list->free_slots = free_slots;
+        chunked_list->free_slot_capacity = capacity;
+    }
+
+    CHUNK_SLOT_BITMAP(chunk)[pos / 64] &= ~((uint64_t)1 << (pos % 64));
+    uint32_t* generation = &chunk_generations(chunked_list, chunk)[pos];
+    *generation = *generation + 1 ? *generation + 1 : 1; // 0 is reserved for CHUNKED_LIST_INVALID_SLOT_HANDLE
+    chunked_list->free_slots[chunked_list->free_slot_count++] = chunk->slot_base + pos;
+    chunk->item_count--;
+    chunked_list->total_items--;
+    return CHUNKED_LIST_SUCCESS;
+}
+
+void reset_slots(ChunkedList* chunked_list) {
+    // New chunks take over slot numbers, their generations must be newer than all handles out there
+    uint32_t newest = chunked_list->slot_generation;
+    for (size_t idx = 0; idx < chunked_list->slot_chunk_count; ++idx) {
+        const Chunk* chunk = chunked_list->slot_chunks[idx];
+        const uint32_t* generations = chunk_generations(chunked_list, chunk);
+        for (size_t pos = 0; pos < chunk->used / chunked_list->item_size; ++pos) {
+            newest = generations[pos] > newest ? generations[pos] : newest;
+        }
+    }
+    chunked_list->slot_generation = newest + 1 ? newest + 1 : 1;
+    chunked_list->slot_chunk_count = 0;
+    chunked_list->free_slot_count = 0;
+}
+
+int chunked_list_expand_slot(CHUNKED_LIST_HANDLE list, void** pnewItem, CHUNKED_LIST_SLOT_HANDLE* handle) {
+    ChunkedList* chunked_list = (ChunkedList*)list;
+    if (!CHUNKED_LIST_IS_SLOT_MAP(chunked_list)) {
+        return CHUNKED_LIST_ERROR_INVALID_OPERATION;
+    }
+
+    Chunk* chunk;
+    size_t pos;
+    if (chunked_list->free_slot_count) {
+        // Reuse the most recently freed slot, its memory is likely still cached
+        size_t slot = chunked_list->free_slots[--chunked_list->free_slot_count];
+        chunk = chunked_list->slot_chunks[slot / chunked_list->slots_per_chunk];
+        pos = slot % chunked_list->slots_per_chunk;
+        chunked_list->total_items++;
+        CHUNKED_LIST_STAT_INC(chunked_list, expand_count); // append_item counts the other path
+    } else {
+        void* destination;
+        int error_code = append_item(chunked_list, &destination);
+        if (CHUNKED_LIST_SUCCESS != error_code) {
+            return error_code;
+        }
+        chunk = chunked_list->tail;
+        pos = chunk->used / chunked_list->item_size - 1;
+    }
+
+    CHUNK_SLOT_BITMAP(chunk)[pos / 64] |= (uint64_t)1 << (pos % 64);
+    chunk->item_count++;
+    *pnewItem = chunk->data + pos * chunked_list->item_size;
+    if (handle) {
+        *handle = slot_handle(chunked_list, chunk, pos);
+    }
+    return CHUNKED_LIST_SUCCESS;
+}
+
+int chunked_list_add_slot(CHUNKED_LIST_HANDLE list, const void* item, CHUNKED_LIST_SLOT_HANDLE* handle) {
+    ChunkedList* chunked_list = (ChunkedList*)list;
+    void* destination;
+    int error_code = chunked_list_expand_slot(list, &destination, handle);
+    if (CHUNKED_LIST_SUCCESS != error_code) {
+        return error_code;
+    }
+    memcpy(destination, item, chunked_list->item_size);
+    CHUNKED_LIST_STAT_INC(chunked_list, add_count);
+    return CHUNKED_LIST_SUCCESS;
+}
+
+int chunked_list_at_slot(CHUNKED_LIST_HANDLE list, CHUNKED_LIST_SLOT_HANDLE handle, void** item) {
+    ChunkedList* chunked_list = (ChunkedList*)list;
+    if (!CHUNKED_LIST_IS_SLOT_MAP(chunked_list)) {
+        return CHUNKED_LIST_ERROR_INVALID_OPERATION;
+    }
+    CHUNKED_LIST_STAT_INC(chunked_list, at_count);
+
+    size_t pos;
+    Chunk* chunk = resolve_handle(chunked_list, handle, &pos);
+    if (!chunk) {
+        return CHUNKED_LIST_ERROR_INVALID_INDEX;
+    }
+    *item = chunk->data + pos * chunked_list->item_size;
+    return CHUNKED_LIST_SUCCESS;
+}
+
+int chunked_list_remove_slot(CHUNKED_LIST_HANDLE list, CHUNKED_LIST_SLOT_HANDLE handle) {
+    ChunkedList* chunked_list = (ChunkedList*)list;
+    if (!CHUNKED_LIST_IS_SLOT_MAP(chunked_list)) {
+        return CHUNKED_LIST_ERROR_INVALID_OPERATION;
+    }
+
+    size_t pos;
+    Chunk* chunk = resolve_handle(chunked_list, handle, &pos);
+    if (!chunk) {
+        return CHUNKED_LIST_ERROR_INVALID_INDEX;
+    }
+    int error_code = free_slot(chunked_list, chunk, pos);
+    if (CHUNKED_LIST_SUCCESS == error_code) {
+        CHUNKED_LIST_STAT_INC(chunked_list, remove_count);
+    }
+    return error_code;
+}
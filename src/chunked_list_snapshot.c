@@ -0,0 +1,57 @@
+#include "chunked_list_snapshot.h"
+#include "chunked_list_imp.h"
+
+CHUNKED_LIST_HANDLE chunked_list_snapshot(CHUNKED_LIST_HANDLE list) {
+    ChunkedList* chunked_list = (ChunkedList*)list;
+    if (CHUNKED_LIST_IS_SLOT_MAP(chunked_list)) {
+        return NULL; // Handles address chunks by position, a snapshot drops the empty ones
+    }
+    ChunkedList* snapshot = (ChunkedList*)chunked_list_create_ex(chunked_list->item_size, chunked_list->chunk_size, chunked_list->flags);
+    if (!snapshot) {
+        return NULL;
+    }
+    snapshot->key_extractor = chunked_list->key_extractor;
+
+    size_t chunk_count = 0;
+    for (Chunk* current = chunked_list->head; current; current = current->next) {
+        chunk_count += current->used ? 1 : 0;
+    }
+    if (chunk_count == 0) {
+        return snapshot;
+    }
+
+    // The snapshot chunks only borrow items, so their headers fit in a single allocation
+    ChunkSlab* slab = create_slab(chunk_count, 0);
+    if (!slab) {
+        chunked_list_destroy(snapshot);
+        return NULL;
+    }
+
+    Chunk** link = &snapshot->head;
+    size_t idx = 0;
+    for (Chunk* current = chunked_list->head; current; current = current->next) {
+        if (current->used == 0) {
+            continue;
+        }
+
+        Chunk* chunk = slab_chunk(slab, idx++, 0);
+        chunk->source = current->source ? current->source : current;
+        CHUNKED_LIST_ATOMIC_INC(&chunk->source->refcount);
+        chunk->data = current->data;
+        chunk->node = current->node;
+        chunk->capacity = current->capacity;
+        chunk->used = current->used;
+        chunk->item_count = current->item_count;
+        chunk->key_count = current->key_count;
+        chunk->key_min = current->key_min;
+        chunk->key_max = current->key_max;
+        chunk->compressed_size = current->compressed_size;
+
+        *link = chunk;
+        link = &chunk->next;
+        snapshot->tail = chunk;
+    }
+    snapshot->total_items = chunked_list->total_items;
+
+    return snapshot;
+}
@@ -0,0 +1,152 @@
+#include <stdlib.h>
+
+#include "chunked_list_sorted.h"
+#include "chunked_list_imp.h"
+
+int update_chunk_index(ChunkedList* chunked_list) {
+    if (chunked_list->chunk_index_valid) {
+        return CHUNKED_LIST_SUCCESS;
+    }
+
+    size_t count = 0;
+    size_t first_index = 0;
+    for (Chunk* current = chunked_list->head; current; current = current->next) {
+        if (current->used == 0) {
+            continue; // Empty chunks have no boundary key
+        }
+
+        if (count == chunked_list->chunk_index_capacity) {
+            size_t capacity = chunked_list->chunk_index_capacity ? chunked_list->chunk_index_capacity * 2 : 16;
+            ChunkIndexEntry* entries = (ChunkIndexEntry*)realloc(chunked_list->chunk_index, capacity * sizeof(ChunkIndexEntry));
+            if (!entries) {
+                return CHUNKED_LIST_ERROR_ALLOCATION_FAILED;
+            }
+            chunked_list->chunk_index = entries;
+            chunked_list->chunk_index_capacity = capacity;
+        }
+
+        chunked_list->chunk_index[count].chunk = current;
+        chunked_list->chunk_index[count].first_index = first_index;
+        first_index += current->used / chunked_list->item_size;
+        count++;
+    }
+
+    chunked_list->chunk_index_count = count;
+    chunked_list->chunk_index_valid = 1;
+    return CHUNKED_LIST_SUCCESS;
+}
+
+// Items of the chunk of an index entry, decompressing the chunk if necessary
+static char* entry_data(ChunkedList* chunked_list, ChunkIndexEntry* entry) {
+    Chunk* chunk = touch_chunk(chunked_list, entry->chunk);
+    return chunk ? chunk->data : NULL;
+}
+
+// Partition predicate, lower bound: item < key, upper bound: !(key < item)
+static int item_before_key(const void* item, const void* key, CHUNKED_LIST_LESS less, void* context, int upper) {
+    return upper ? !less(key, item, context) : less(item, key, context);
+}
+
+// Binary search for the first index entry whose first item the predicate is false for. Compressed
+// chunks stay compressed, only their first items are decoded
+static int search_chunk_index(ChunkedList* chunked_list, const void* key, CHUNKED_LIST_LESS less, void* context,
+                              int upper, size_t* entry) {
+    int64_t small_buffer[8];
+    char* buffer = chunked_list->item_size <= sizeof(small_buffer) ? (char*)small_buffer
+                                                                   : (char*)malloc(chunked_list->item_size);
+    if (!buffer) {
+        return CHUNKED_LIST_ERROR_ALLOCATION_FAILED;
+    }
+
+    size_t low = 0;
+    size_t high = chunked_list->chunk_index_count;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        const char* first_item = chunk_first_item(chunked_list, chunked_list->chunk_index[middle].chunk, buffer);
+        if (item_before_key(first_item, key, less, context, upper)) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    if (buffer != (char*)small_buffer) {
+        free(buffer);
+    }
+    *entry = low;
+    return CHUNKED_LIST_SUCCESS;
+}
+
+// Binary search for the first item the predicate is false for; items must be partitioned by it
+static int search_partition(ChunkedList* chunked_list, const void* key, CHUNKED_LIST_LESS less, void* context,
+                            int upper, size_t* index, void** item) {
+    if (CHUNKED_LIST_IS_VARIABLE_LENGTH(chunked_list) || CHUNKED_LIST_IS_SLOT_MAP(chunked_list)) {
+        return CHUNKED_LIST_ERROR_INVALID_OPERATION;
+    }
+    CHUNKED_LIST_STAT_INC(chunked_list, search_count);
+    int error_code = update_chunk_index(chunked_list);
+    if (CHUNKED_LIST_SUCCESS != error_code) {
+        return error_code;
+    }
+
+    // Find the first chunk whose first item is not before the key
+    size_t low;
+    error_code = search_chunk_index(chunked_list, key, less, context, upper, &low);
+    if (CHUNKED_LIST_SUCCESS != error_code) {
+        return error_code;
+    }
+
+    if (low == 0) {
+        *index = 0;
+        if (item && chunked_list->chunk_index_count) {
+            *item = entry_data(chunked_list, &chunked_list->chunk_index[0]);
+            if (!*item) {
+                return CHUNKED_LIST_ERROR_ALLOCATION_FAILED;
+            }
+        } else if (item) {
+            *item = NULL;
+        }
+        return CHUNKED_LIST_SUCCESS;
+    }
+
+    // The partition point lies in the previous chunk or right after it, only that chunk is decompressed
+    ChunkIndexEntry* entry = &chunked_list->chunk_index[low - 1];
+    if (!entry_data(chunked_list, entry)) {
+        return CHUNKED_LIST_ERROR_ALLOCATION_FAILED;
+    }
+    size_t chunk_low = 1;
+    size_t chunk_high = entry->chunk->used / chunked_list->item_size;
+    while (chunk_low < chunk_high) {
+        size_t middle = chunk_low + (chunk_high - chunk_low) / 2;
+        if (item_before_key(entry->chunk->data + middle * chunked_list->item_size, key, less, context, upper)) {
+            chunk_low = middle + 1;
+        } else {
+            chunk_high = middle;
+        }
+    }
+
+    *index = entry->first_index + chunk_low;
+    if (item) {
+        if (chunk_low < entry->chunk->used / chunked_list->item_size) {
+            *item = entry->chunk->data + chunk_low * chunked_list->item_size;
+        } else if (low < chunked_list->chunk_index_count) {
+            *item = entry_data(chunked_list, &chunked_list->chunk_index[low]);
+            if (!*item) {
+                return CHUNKED_LIST_ERROR_ALLOCATION_FAILED;
+            }
+        } else {
+            *item = NULL;
+        }
+    }
+    return CHUNKED_LIST_SUCCESS;
+}
+
+int chunked_list_lower_bound(CHUNKED_LIST_HANDLE list, const void* key, CHUNKED_LIST_LESS less, void* context,
+                             size_t* index, void** item) {
+    return search_partition((ChunkedList*)list, key, less, context, 0, index, item);
+}
+
+int chunked_list_upper_bound(CHUNKED_LIST_HANDLE list, const void* key, CHUNKED_LIST_LESS less, void* context,
+                             size_t* index, void** item) {
+    return search_partition((ChunkedList*)list, key, less, context, 1, index, item);
+}
@@ -0,0 +1,72 @@
+#include <string.h>
+
+#include "chunked_list_stats.h"
+#include "chunked_list_imp.h"
+
+int chunked_list_get_stats(CHUNKED_LIST_HANDLE list, CHUNKED_LIST_STATS* stats) {
+    ChunkedList* chunked_list = (ChunkedList*)list;
+    memset(stats, 0, sizeof(CHUNKED_LIST_STATS));
+
+    size_t bytes_uncompressed = 0;
+    for (Chunk* current = chunked_list->head; current; current = current->next) {
+        size_t payload_size = current->compressed_size ? chunked_list->chunk_size : current->capacity;
+        size_t bucket = current->used * CHUNKED_LIST_STATS_HISTOGRAM_BUCKETS / payload_size;
+        if (bucket >= CHUNKED_LIST_STATS_HISTOGRAM_BUCKETS) {
+            bucket = CHUNKED_LIST_STATS_HISTOGRAM_BUCKETS - 1;
+        }
+
+        stats->chunk_count++;
+        stats->empty_chunks += current->used == 0 ? 1 : 0;
+        stats->shared_chunks += CHUNK_IS_EXCLUSIVE(current) ? 0 : 1;
+        stats->bytes_reserved += sizeof(Chunk) + (current->source ? 0 : current->capacity + chunked_list->slot_header_size);
+        stats->bytes_used += current->used;
+        stats->occupancy_histogram[bucket]++;
+        if (current->compressed_size) {
+            stats->compressed_chunks++;
+            stats->bytes_compressed += current->compressed_size;
+            bytes_uncompressed += current->used;
+        }
+    }
+    if (stats->bytes_compressed) {
+        stats->compression_ratio = (double)bytes_uncompressed / (double)stats->bytes_compressed;
+    }
+    stats->spare_chunks = chunked_list->spare_count;
+    stats->bytes_reserved += chunked_list->spare_count * (sizeof(Chunk) + chunked_list->chunk_size);
+
+#ifdef CHUNKED_LIST_ENABLE_STATS
+    const ChunkedListCounters* counters = &chunked_list->counters;
+    stats->counters_enabled = 1;
+    stats->add_count = counters->add_count;
+    stats->expand_count = counters->expand_count;
+    stats->insert_count = counters->insert_count;
+    stats->at_count = counters->at_count;
+    stats->remove_count = counters->remove_count;
+    stats->clear_count = counters->clear_count;
+    stats->search_count = counters->search_count;
+    stats->scan_count = counters->scan_count;
+    stats->scan_chunks_skipped = counters->scan_chunks_skipped;
+    stats->chunk_allocations = counters->chunk_allocations;
+    stats->at_chunks_walked = counters->at_chunks_walked;
+    if (counters->at_count) {
+        stats->avg_at_chunks_walked = (double)counters->at_chunks_walked / (double)counters->at_count;
+    }
+    stats->compress_count = counters->compress_count;
+    stats->decompress_count = counters->decompress_count;
+    stats->decompress_ns = counters->decompress_ns;
+    if (counters->decompress_count) {
+        stats->avg_decompress_ns = (double)counters->decompress_ns / (double)counters->decompress_count;
+    }
+#endif
+
+    return CHUNKED_LIST_SUCCESS;
+}
+
+int chunked_list_reset_stats(CHUNKED_LIST_HANDLE list) {
+#ifdef CHUNKED_LIST_ENABLE_STATS
+    ChunkedList* chunked_list = (ChunkedList*)list;
+    memset(&chunked_list->counters, 0, sizeof(ChunkedListCounters));
+#else
+    (void)list;
+#endif
+    return CHUNKED_LIST_SUCCESS;
+}
@@ -1,7 +1,21 @@
 #include "gtest/gtest.h"
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <vector>
 
 #include "chunked_list.h"  
+#include "chunked_list_bytes.h"
+#include "chunked_list_compress.h"
 #include "chunked_list_iterator.h"  
+#include "chunked_list_layout.h"
+#include "chunked_list_numa.h"
+#include "chunked_list_readers.h"
+#include "chunked_list_scan.h"
+#include "chunked_list_slots.h"
+#include "chunked_list_snapshot.h"
+#include "chunked_list_sorted.h"
+#include "chunked_list_stats.h"
 
 // Test Fixture Class
 class ChunkedListTest : public ::testing::Test {
@@ -151,6 +165,800 @@ TEST_F(ChunkedListTest, AddAndRetrieveRemoveManyItem) {
 
 }
 
+static int64_t int_key(const void* item) {
+    return *(const int*)item;
+}
+
+struct ScanResult {
+    size_t count;
+    size_t first_index;
+    int first_value;
+};
+
+static int collect_items(void* item, size_t index, void* context) {
+    ScanResult* result = (ScanResult*)context;
+    if (result->count++ == 0) {
+        result->first_index = index;
+        result->first_value = *(int*)item;
+    }
+    return 0;
+}
+
+// Test: Range scans using per-chunk key summaries
+TEST_F(ChunkedListTest, ScanRange) {
+    ScanResult result = {};
+    EXPECT_EQ(chunked_list_scan_range(list, 0, 10, collect_items, &result), CHUNKED_LIST_ERROR_INVALID_OPERATION);
+
+    int COUNT = 1024 / sizeof(int) * 8;
+    for (int idx = 0; idx < COUNT; ++idx) {
+        ASSERT_EQ(chunked_list_add(list, &idx), CHUNKED_LIST_SUCCESS);
+    }
+    EXPECT_EQ(chunked_list_set_key_extractor(list, int_key), CHUNKED_LIST_SUCCESS);
+
+    // Items created by expand are summarized lazily
+    int* pitem;
+    ASSERT_EQ(chunked_list_expand(list, (void**)&pitem), CHUNKED_LIST_SUCCESS);
+    *pitem = COUNT;
+
+    EXPECT_EQ(chunked_list_scan_range(list, 300, 599, collect_items, &result), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(result.count, 300UL);
+    EXPECT_EQ(result.first_index, 300UL);
+    EXPECT_EQ(result.first_value, 300);
+
+    result = ScanResult();
+    EXPECT_EQ(chunked_list_scan_range(list, COUNT, COUNT, collect_items, &result), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(result.count, 1UL);
+    EXPECT_EQ(result.first_index, (size_t)COUNT);
+
+    // Removing the chunk minimum must not leave a stale summary behind
+    EXPECT_EQ(chunked_list_remove(list, 256), CHUNKED_LIST_SUCCESS);
+    int value = 1000000;
+    EXPECT_EQ(chunked_list_add(list, &value), CHUNKED_LIST_SUCCESS);
+
+    result = ScanResult();
+    EXPECT_EQ(chunked_list_scan_range(list, 256, 256, collect_items, &result), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(result.count, 0UL);
+
+    result = ScanResult();
+    EXPECT_EQ(chunked_list_scan_range(list, 257, 257, collect_items, &result), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(result.count, 1UL);
+    EXPECT_EQ(result.first_index, 256UL);
+
+    result = ScanResult();
+    EXPECT_EQ(chunked_list_scan_range(list, value, value, collect_items, &result), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(result.count, 1UL);
+    EXPECT_EQ(result.first_index, (size_t)COUNT);
+
+    // Compressed chunks keep complete summaries, skipped ones stay compressed (the second chunk is not full)
+    size_t compressed;
+    CHUNKED_LIST_STATS stats;
+    EXPECT_EQ(chunked_list_compress_cold(list, 0, &compressed), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(compressed, 7UL);
+    result = ScanResult();
+    EXPECT_EQ(chunked_list_scan_range(list, 600, 602, collect_items, &result), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(result.count, 3UL);
+    EXPECT_EQ(result.first_index, 599UL);
+    EXPECT_EQ(chunked_list_get_stats(list, &stats), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(stats.compressed_chunks, 6UL);
+
+    // Inserted items are summarized once they were written, also after the chunk is compressed again
+    EXPECT_EQ(chunked_list_insert(list, 10, (void**)&pitem), CHUNKED_LIST_SUCCESS);
+    *pitem = -5;
+    result = ScanResult();
+    EXPECT_EQ(chunked_list_scan_range(list, -5, -5, collect_items, &result), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(result.count, 1UL);
+    EXPECT_EQ(result.first_index, 10UL);
+    EXPECT_EQ(chunked_list_insert(list, 20, (void**)&pitem), CHUNKED_LIST_SUCCESS);
+    *pitem = -6;
+    EXPECT_EQ(chunked_list_compress_cold(list, 0, &compressed), CHUNKED_LIST_SUCCESS);
+    result = ScanResult();
+    EXPECT_EQ(chunked_list_scan_range(list, -6, -5, collect_items, &result), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(result.count, 2UL);
+    EXPECT_EQ(result.first_index, 10UL);
+    EXPECT_EQ(result.first_value, -5);
+}
+
+static int int_less(const void* lhs, const void* rhs, void*) {
+    return *(const int*)lhs < *(const int*)rhs;
+}
+
+// Test: Inserting items splits full chunks
+TEST_F(ChunkedListTest, InsertItem) {
+    int ITEMS_PER_CHUNK = 1024 / sizeof(int);
+    int* pitem;
+
+    EXPECT_EQ(chunked_list_insert(list, 1, (void**)&pitem), CHUNKED_LIST_ERROR_INVALID_INDEX);
+
+    // Even values first, then the odd values are inserted in between
+    for (int idx = 0; idx < ITEMS_PER_CHUNK * 2; ++idx) {
+        int value = idx * 2;
+        ASSERT_EQ(chunked_list_add(list, &value), CHUNKED_LIST_SUCCESS);
+    }
+    for (int idx = 0; idx < ITEMS_PER_CHUNK * 2; ++idx) {
+        ASSERT_EQ(chunked_list_insert(list, idx * 2 + 1, (void**)&pitem), CHUNKED_LIST_SUCCESS);
+        *pitem = idx * 2 + 1;
+    }
+    EXPECT_EQ(chunked_list_count(list), (size_t)(ITEMS_PER_CHUNK * 4));
+
+    int* retrieved_item;
+    for (int idx = 0; idx < ITEMS_PER_CHUNK * 4; ++idx) {
+        ASSERT_EQ(chunked_list_at(list, idx, (void**)&retrieved_item), CHUNKED_LIST_SUCCESS);
+        ASSERT_EQ(*retrieved_item, idx);
+    }
+}
+
+// Test: Binary searches in a sorted list
+TEST_F(ChunkedListTest, SortedSearch) {
+    int COUNT = 1024 / sizeof(int) * 5;
+    size_t index;
+    int* pitem;
+
+    int key = 7;
+    EXPECT_EQ(chunked_list_lower_bound(list, &key, int_less, NULL, &index, (void**)&pitem), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(index, 0UL);
+    EXPECT_EQ(pitem, nullptr);
+
+    // Every value is stored twice: 0, 0, 2, 2, 4, 4, ...
+    for (int idx = 0; idx < COUNT; ++idx) {
+        int value = idx / 2 * 2;
+        ASSERT_EQ(chunked_list_add(list, &value), CHUNKED_LIST_SUCCESS);
+    }
+
+    for (int value = -1; value <= COUNT; ++value) {
+        size_t expected_lower = value < 0 ? 0 : (size_t)((value + 1) / 2 * 2);
+        size_t expected_upper = value < 0 ? 0 : (size_t)(value / 2 * 2 + 2);
+        if (expected_upper > (size_t)COUNT) {
+            expected_upper = COUNT;
+        }
+
+        ASSERT_EQ(chunked_list_lower_bound(list, &value, int_less, NULL, &index, (void**)&pitem), CHUNKED_LIST_SUCCESS);
+        ASSERT_EQ(index, expected_lower);
+        if (index < (size_t)COUNT) {
+            ASSERT_EQ(*pitem, (int)(index / 2 * 2));
+        } else {
+            ASSERT_EQ(pitem, nullptr);
+        }
+
+        ASSERT_EQ(chunked_list_upper_bound(list, &value, int_less, NULL, &index, NULL), CHUNKED_LIST_SUCCESS);
+        ASSERT_EQ(index, expected_upper);
+    }
+
+    // The chunk index follows removals
+    EXPECT_EQ(chunked_list_remove(list, 0), CHUNKED_LIST_SUCCESS);
+    key = 2;
+    EXPECT_EQ(chunked_list_lower_bound(list, &key, int_less, NULL, &index, NULL), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(index, 1UL);
+}
+
+// Test: Layout statistics and operation counters
+TEST_F(ChunkedListTest, Stats) {
+    int ITEMS_PER_CHUNK = 1024 / sizeof(int);
+    CHUNKED_LIST_STATS stats;
+
+    EXPECT_EQ(chunked_list_get_stats(list, &stats), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(stats.chunk_count, 0UL);
+
+    for (int idx = 0; idx < ITEMS_PER_CHUNK * 2 + ITEMS_PER_CHUNK / 2; ++idx) {
+        ASSERT_EQ(chunked_list_add(list, &idx), CHUNKED_LIST_SUCCESS);
+    }
+    for (int idx = 0; idx < ITEMS_PER_CHUNK; ++idx) {
+        ASSERT_EQ(chunked_list_remove(list, 0), CHUNKED_LIST_SUCCESS);
+    }
+    int* retrieved_item;
+    EXPECT_EQ(chunked_list_at(list, ITEMS_PER_CHUNK, (void**)&retrieved_item), CHUNKED_LIST_SUCCESS);
+
+    // Failed calls are not counted
+    size_t count = chunked_list_count(list);
+    EXPECT_EQ(chunked_list_remove(list, count), CHUNKED_LIST_ERROR_INVALID_INDEX);
+    EXPECT_EQ(chunked_list_insert(list, count + 1, (void**)&retrieved_item), CHUNKED_LIST_ERROR_INVALID_INDEX);
+
+    EXPECT_EQ(chunked_list_get_stats(list, &stats), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(stats.chunk_count, 3UL);
+    EXPECT_EQ(stats.empty_chunks, 1UL);
+    EXPECT_EQ(stats.bytes_used, ITEMS_PER_CHUNK * 1.5 * sizeof(int));
+    EXPECT_GE(stats.bytes_reserved, 3 * 1024UL);
+    EXPECT_EQ(stats.occupancy_histogram[0], 1UL);
+    EXPECT_EQ(stats.occupancy_histogram[5], 1UL);
+    EXPECT_EQ(stats.occupancy_histogram[CHUNKED_LIST_STATS_HISTOGRAM_BUCKETS - 1], 1UL);
+
+#ifdef CHUNKED_LIST_ENABLE_STATS
+    EXPECT_EQ(stats.counters_enabled, 1);
+    EXPECT_EQ(stats.add_count, (size_t)(ITEMS_PER_CHUNK * 2 + ITEMS_PER_CHUNK / 2));
+    EXPECT_EQ(stats.expand_count, stats.add_count);
+    EXPECT_EQ(stats.remove_count, (size_t)ITEMS_PER_CHUNK);
+    EXPECT_EQ(stats.insert_count, 0UL);
+    EXPECT_EQ(stats.chunk_allocations, 3UL);
+    EXPECT_EQ(stats.at_count, 1UL);
+    EXPECT_EQ(stats.at_chunks_walked, 3UL);
+    EXPECT_DOUBLE_EQ(stats.avg_at_chunks_walked, 3.0);
+
+    EXPECT_EQ(chunked_list_reset_stats(list), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(chunked_list_get_stats(list, &stats), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(stats.add_count, 0UL);
+#else
+    EXPECT_EQ(stats.counters_enabled, 0);
+    EXPECT_EQ(stats.add_count, 0UL);
+#endif
+}
+
+// Test: Reserving capacity up front
+TEST_F(ChunkedListTest, ReserveCapacity) {
+    int ITEMS_PER_CHUNK = 1024 / sizeof(int);
+    int COUNT = ITEMS_PER_CHUNK * 4 + 10;
+
+    EXPECT_EQ(chunked_list_capacity(list), 0UL);
+    int value = 0;
+    EXPECT_EQ(chunked_list_add(list, &value), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(chunked_list_capacity(list), (size_t)ITEMS_PER_CHUNK);
+
+    EXPECT_EQ(chunked_list_reserve(list, COUNT), CHUNKED_LIST_SUCCESS);
+    EXPECT_GE(chunked_list_capacity(list), (size_t)COUNT);
+    EXPECT_LT(chunked_list_capacity(list), (size_t)(COUNT + ITEMS_PER_CHUNK));
+
+    // Reserving less than the capacity is a no-op
+    size_t capacity = chunked_list_capacity(list);
+    EXPECT_EQ(chunked_list_reserve(list, 10), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(chunked_list_capacity(list), capacity);
+
+    CHUNKED_LIST_STATS stats;
+    EXPECT_EQ(chunked_list_get_stats(list, &stats), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(stats.spare_chunks, 4UL);
+
+    for (value = 1; value < COUNT; ++value) {
+        ASSERT_EQ(chunked_list_add(list, &value), CHUNKED_LIST_SUCCESS);
+    }
+    EXPECT_EQ(chunked_list_capacity(list), capacity);
+
+    int* retrieved_item;
+    for (int idx = 0; idx < COUNT; ++idx) {
+        ASSERT_EQ(chunked_list_at(list, idx, (void**)&retrieved_item), CHUNKED_LIST_SUCCESS);
+        ASSERT_EQ(*retrieved_item, idx);
+    }
+
+#ifdef CHUNKED_LIST_ENABLE_STATS
+    EXPECT_EQ(chunked_list_get_stats(list, &stats), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(stats.chunk_allocations, 2UL); // First chunk and the slab
+#endif
+
+    EXPECT_EQ(chunked_list_clear(list), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(chunked_list_capacity(list), 0UL);
+}
+
+// Test: Snapshots keep their items while the list is modified
+TEST_F(ChunkedListTest, Snapshot) {
+    int ITEMS_PER_CHUNK = 1024 / sizeof(int);
+    int COUNT = ITEMS_PER_CHUNK * 3 + ITEMS_PER_CHUNK / 2;
+    for (int idx = 0; idx < COUNT; ++idx) {
+        ASSERT_EQ(chunked_list_add(list, &idx), CHUNKED_LIST_SUCCESS);
+    }
+
+    CHUNKED_LIST_HANDLE snapshot = chunked_list_snapshot(list);
+    ASSERT_NE(snapshot, nullptr);
+    EXPECT_EQ(chunked_list_count(snapshot), (size_t)COUNT);
+
+    CHUNKED_LIST_STATS stats;
+    EXPECT_EQ(chunked_list_get_stats(snapshot, &stats), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(stats.shared_chunks, 4UL);
+    EXPECT_LT(stats.bytes_reserved, 1024UL);
+
+    // Items are shared, not copied
+    int* item_in_list;
+    int* item_in_snapshot;
+    EXPECT_EQ(chunked_list_at(list, 10, (void**)&item_in_list), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(chunked_list_at(snapshot, 10, (void**)&item_in_snapshot), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(item_in_list, item_in_snapshot);
+
+    // Modify the list: append to the shared tail, remove and insert in shared chunks
+    int value = -1;
+    EXPECT_EQ(chunked_list_add(list, &value), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(chunked_list_remove(list, 0), CHUNKED_LIST_SUCCESS);
+    int* pitem;
+    EXPECT_EQ(chunked_list_insert(list, ITEMS_PER_CHUNK * 2, (void**)&pitem), CHUNKED_LIST_SUCCESS);
+    *pitem = -2;
+
+    // Modify the snapshot of the snapshot
+    CHUNKED_LIST_HANDLE nested = chunked_list_snapshot(snapshot);
+    ASSERT_NE(nested, nullptr);
+    EXPECT_EQ(chunked_list_add(nested, &value), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(chunked_list_remove(nested, COUNT - 1), CHUNKED_LIST_SUCCESS);
+
+    // The untouched chunk is still shared
+    EXPECT_EQ(chunked_list_at(list, ITEMS_PER_CHUNK, (void**)&item_in_list), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(chunked_list_at(snapshot, ITEMS_PER_CHUNK + 1, (void**)&item_in_snapshot), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(item_in_list, item_in_snapshot);
+
+    // The snapshot still sees the original items, also after the list is cleared
+    EXPECT_EQ(chunked_list_clear(list), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(chunked_list_count(snapshot), (size_t)COUNT);
+    int expected = 0;
+    CHUNKED_LIST_ITERATOR_HANDLE iter = chunked_list_iterator_create(snapshot);
+    while (chunked_list_iterator_is_end(iter) != 1) {
+        ASSERT_EQ(chunked_list_iterator_get(iter, (void**)&item_in_snapshot), CHUNKED_LIST_ITERATOR_SUCCESS);
+        ASSERT_EQ(*item_in_snapshot, expected++);
+        ASSERT_EQ(chunked_list_iterator_next(iter), CHUNKED_LIST_ITERATOR_SUCCESS);
+    }
+    chunked_list_iterator_destroy(iter);
+    EXPECT_EQ(expected, COUNT);
+
+    EXPECT_EQ(chunked_list_count(nested), (size_t)COUNT);
+    EXPECT_EQ(chunked_list_at(nested, COUNT - 1, (void**)&pitem), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(*pitem, -1);
+    EXPECT_EQ(chunked_list_at(nested, COUNT - 2, (void**)&pitem), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(*pitem, COUNT - 2);
+
+    chunked_list_destroy(snapshot);
+    chunked_list_destroy(nested);
+}
+
+TEST_F(ChunkedListTest, CompressCold) {
+    int ITEMS_PER_CHUNK = 1024 / sizeof(int);
+    int COUNT = ITEMS_PER_CHUNK * 4 + ITEMS_PER_CHUNK / 2;
+    for (int idx = 0; idx < COUNT; ++idx) {
+        int value = idx * 2;
+        ASSERT_EQ(chunked_list_add(list, &value), CHUNKED_LIST_SUCCESS);
+    }
+    EXPECT_EQ(chunked_list_set_key_extractor(list, int_key), CHUNKED_LIST_SUCCESS);
+
+    // Nothing is idle during the first sweep
+    size_t compressed;
+    EXPECT_EQ(chunked_list_compress_cold(list, 1, &compressed), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(compressed, 0UL);
+
+    // The accessed first chunk and the partially filled tail stay uncompressed
+    int* pitem;
+    EXPECT_EQ(chunked_list_at(list, 10, (void**)&pitem), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(chunked_list_compress_cold(list, 1, &compressed), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(compressed, 3UL);
+
+    CHUNKED_LIST_STATS stats;
+    EXPECT_EQ(chunked_list_get_stats(list, &stats), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(stats.compressed_chunks, 3UL);
+    EXPECT_GE(stats.compression_ratio, 3.0);
+    EXPECT_EQ(stats.bytes_used, COUNT * sizeof(int));
+    EXPECT_LT(stats.bytes_reserved, 4 * 1024UL);
+
+    // Snapshots share compressed chunks and decompress their own copies
+    CHUNKED_LIST_HANDLE snapshot = chunked_list_snapshot(list);
+    ASSERT_NE(snapshot, nullptr);
+    EXPECT_EQ(chunked_list_at(snapshot, ITEMS_PER_CHUNK * 3 + 7, (void**)&pitem), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(*pitem, (ITEMS_PER_CHUNK * 3 + 7) * 2);
+
+    // Items are decompressed on access by lookups, removals and range scans; a binary search
+    // only decompresses the chunk it searches
+    size_t index;
+    int key = ITEMS_PER_CHUNK * 2 + 1;
+    EXPECT_EQ(chunked_list_lower_bound(list, &key, int_less, nullptr, &index, (void**)&pitem), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(index, (size_t)(ITEMS_PER_CHUNK + 1));
+    EXPECT_EQ(*pitem, key + 1);
+    EXPECT_EQ(chunked_list_get_stats(list, &stats), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(stats.compressed_chunks, 2UL);
+    key = ITEMS_PER_CHUNK * 4;  // First item of the third chunk
+    EXPECT_EQ(chunked_list_upper_bound(list, &key, int_less, nullptr, &index, nullptr), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(index, (size_t)(ITEMS_PER_CHUNK * 2 + 1));
+    EXPECT_EQ(chunked_list_get_stats(list, &stats), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(stats.compressed_chunks, 1UL);
+
+    EXPECT_EQ(chunked_list_remove(list, ITEMS_PER_CHUNK * 3), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(chunked_list_get_stats(list, &stats), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(stats.compressed_chunks, 0UL);
+#ifdef CHUNKED_LIST_ENABLE_STATS
+    EXPECT_EQ(stats.compress_count, 3UL);
+    EXPECT_EQ(stats.decompress_count, 3UL);
+#endif
+
+    ScanResult result = { 0, 0, 0 };
+    EXPECT_EQ(chunked_list_scan_range(list, ITEMS_PER_CHUNK * 6 + 2, ITEMS_PER_CHUNK * 6 + 6, collect_items, &result),
+              CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(result.count, 3UL);
+    EXPECT_EQ(result.first_index, (size_t)(ITEMS_PER_CHUNK * 3));
+
+    int expected = 0;
+    CHUNKED_LIST_ITERATOR_HANDLE iter = chunked_list_iterator_create(snapshot);
+    while (chunked_list_iterator_is_end(iter) != 1) {
+        ASSERT_EQ(chunked_list_iterator_get(iter, (void**)&pitem), CHUNKED_LIST_ITERATOR_SUCCESS);
+        ASSERT_EQ(*pitem, expected * 2);
+        expected++;
+        ASSERT_EQ(chunked_list_iterator_next(iter), CHUNKED_LIST_ITERATOR_SUCCESS);
+    }
+    chunked_list_iterator_destroy(iter);
+    EXPECT_EQ(expected, COUNT);
+    chunked_list_destroy(snapshot);
+}
+
+TEST(ChunkedListBytesTest, VariableLengthItems) {
+    CHUNKED_LIST_HANDLE list = chunked_list_create_ex(0, 256, CHUNKED_LIST_FLAG_VARIABLE_LENGTH);
+    ASSERT_NE(list, nullptr);
+
+    // Item idx is idx bytes of value idx, some of them larger than a chunk
+    const size_t COUNT = 400;
+    std::vector<char> buffer(COUNT);
+    for (size_t idx = 0; idx < COUNT; ++idx) {
+        memset(buffer.data(), (int)idx, idx);
+        ASSERT_EQ(chunked_list_add_bytes(list, buffer.data(), idx), CHUNKED_LIST_SUCCESS);
+    }
+    EXPECT_EQ(chunked_list_count(list), COUNT);
+
+    char* item;
+    size_t length;
+    EXPECT_EQ(chunked_list_at_bytes(list, 0, (void**)&item, &length), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(length, 0UL);
+    EXPECT_EQ(chunked_list_at_bytes(list, 300, (void**)&item, &length), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(length, 300UL);
+    EXPECT_EQ((unsigned char)item[0], 300 % 256);
+    EXPECT_EQ((unsigned char)item[299], 300 % 256);
+    EXPECT_EQ(chunked_list_at_bytes(list, COUNT, (void**)&item, &length), CHUNKED_LIST_ERROR_INVALID_INDEX);
+
+    // Fixed-size operations are rejected
+    void* pitem;
+    int value = 0;
+    EXPECT_EQ(chunked_list_add(list, &value), CHUNKED_LIST_ERROR_INVALID_OPERATION);
+    EXPECT_EQ(chunked_list_expand(list, &pitem), CHUNKED_LIST_ERROR_INVALID_OPERATION);
+    EXPECT_EQ(chunked_list_insert(list, 0, &pitem), CHUNKED_LIST_ERROR_INVALID_OPERATION);
+    EXPECT_EQ(chunked_list_reserve(list, 10), CHUNKED_LIST_ERROR_INVALID_OPERATION);
+    EXPECT_EQ(chunked_list_set_key_extractor(list, int_key), CHUNKED_LIST_ERROR_INVALID_OPERATION);
+
+    // Removing shifts the items and offsets of the chunk, also in a shared chunk
+    CHUNKED_LIST_HANDLE snapshot = chunked_list_snapshot(list);
+    ASSERT_NE(snapshot, nullptr);
+    EXPECT_EQ(chunked_list_remove(list, 10), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(chunked_list_remove(list, 300), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(chunked_list_count(list), COUNT - 2);
+    EXPECT_EQ(chunked_list_at(list, 10, (void**)&item), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(item[0], 11);
+
+    size_t expected = 0;
+    CHUNKED_LIST_ITERATOR_HANDLE iter = chunked_list_iterator_create(list);
+    while (chunked_list_iterator_is_end(iter) != 1) {
+        expected += (expected == 10 || expected == 301) ? 1 : 0;
+        ASSERT_EQ(chunked_list_iterator_get_bytes(iter, (void**)&item, &length), CHUNKED_LIST_ITERATOR_SUCCESS);
+        ASSERT_EQ(length, expected);
+        for (size_t pos = 0; pos < length; ++pos) {
+            ASSERT_EQ((unsigned char)item[pos], expected % 256);
+        }
+        expected++;
+        ASSERT_EQ(chunked_list_iterator_next(iter), CHUNKED_LIST_ITERATOR_SUCCESS);
+    }
+    chunked_list_iterator_destroy(iter);
+    EXPECT_EQ(expected, COUNT);
+
+    // The snapshot still sees the original items
+    EXPECT_EQ(chunked_list_count(snapshot), COUNT);
+    EXPECT_EQ(chunked_list_at_bytes(snapshot, 10, (void**)&item, &length), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(length, 10UL);
+    EXPECT_EQ(chunked_list_at_bytes(snapshot, 301, (void**)&item, &length), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(length, 301UL);
+
+    chunked_list_destroy(snapshot);
+    chunked_list_destroy(list);
+}
+
+TEST(ChunkedListReadersTest, RetireUntilReadersLeave) {
+    EXPECT_EQ(chunked_list_create_ex(sizeof(int), 64, CHUNKED_LIST_FLAG_READER_SAFE | CHUNKED_LIST_FLAG_VARIABLE_LENGTH), nullptr);
+    CHUNKED_LIST_HANDLE plain = chunked_list_create(sizeof(int), 64);
+    EXPECT_EQ(chunked_list_reader_register(plain), nullptr);
+    chunked_list_destroy(plain);
+
+    CHUNKED_LIST_HANDLE list = chunked_list_create_ex(sizeof(int), 64, CHUNKED_LIST_FLAG_READER_SAFE);
+    ASSERT_NE(list, nullptr);
+    const int COUNT = 100;
+    for (int idx = 0; idx < COUNT; ++idx) {
+        ASSERT_EQ(chunked_list_add(list, &idx), CHUNKED_LIST_SUCCESS);
+    }
+
+    // Operations handing out unwritten items are rejected
+    void* pitem;
+    size_t compressed;
+    EXPECT_EQ(chunked_list_expand(list, &pitem), CHUNKED_LIST_ERROR_INVALID_OPERATION);
+    EXPECT_EQ(chunked_list_insert(list, 0, &pitem), CHUNKED_LIST_ERROR_INVALID_OPERATION);
+    EXPECT_EQ(chunked_list_compress_cold(list, 0, &compressed), CHUNKED_LIST_ERROR_INVALID_OPERATION);
+
+    CHUNKED_LIST_READER_HANDLE reader = chunked_list_reader_register(list);
+    ASSERT_NE(reader, nullptr);
+    chunked_list_reader_enter(reader);
+    CHUNKED_LIST_ITERATOR_HANDLE iter = chunked_list_iterator_create(list);
+    int* first;
+    ASSERT_EQ(chunked_list_iterator_get(iter, (void**)&first), CHUNKED_LIST_ITERATOR_SUCCESS);
+
+    // The removal publishes a copy of the chunk, the reader keeps the old one
+    EXPECT_EQ(chunked_list_remove(list, 0), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(chunked_list_reclaim(list), 1UL);
+    EXPECT_EQ(*first, 0);
+    int expected = 0;
+    while (chunked_list_iterator_is_end(iter) != 1) {
+        int* item;
+        ASSERT_EQ(chunked_list_iterator_get(iter, (void**)&item), CHUNKED_LIST_ITERATOR_SUCCESS);
+        ASSERT_EQ(*item, expected++);
+        ASSERT_EQ(chunked_list_iterator_next(iter), CHUNKED_LIST_ITERATOR_SUCCESS);
+    }
+    EXPECT_EQ(expected, COUNT);
+    chunked_list_iterator_destroy(iter);
+    chunked_list_reader_exit(reader);
+    EXPECT_EQ(chunked_list_reclaim(list), 0UL);
+
+    int* item;
+    EXPECT_EQ(chunked_list_count(list), (size_t)COUNT - 1);
+    EXPECT_EQ(chunked_list_at(list, 0, (void**)&item), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(*item, 1);
+#ifdef CHUNKED_LIST_ENABLE_STATS
+    CHUNKED_LIST_STATS stats;
+    ASSERT_EQ(chunked_list_get_stats(list, &stats), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(stats.at_count, 0UL);  // Lookups of readers do not write to the list
+#endif
+
+    // Chunks cleared during a read section are kept until it ends
+    chunked_list_reader_enter(reader);
+    EXPECT_EQ(chunked_list_clear(list), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(chunked_list_reclaim(list), (size_t)(COUNT * sizeof(int) + 63) / 64);
+    chunked_list_reader_exit(reader);
+    EXPECT_EQ(chunked_list_reclaim(list), 0UL);
+
+    // The slot of an unregistered reader is reused
+    chunked_list_reader_unregister(reader);
+    EXPECT_EQ(chunked_list_reader_register(list), reader);
+    chunked_list_reader_unregister(reader);
+    chunked_list_destroy(list);
+}
+
+struct ParallelScan {
+    std::atomic<size_t> visited{ 0 };
+    std::atomic<size_t> mismatches{ 0 };
+    size_t stop_at = SIZE_MAX;
+};
+
+static int check_index(void* item, size_t index, void* context) {
+    ParallelScan* scan = (ParallelScan*)context;
+    if ((size_t)*(int*)item != index) {
+        scan->mismatches++;
+    }
+    scan->visited++;
+    return index == scan->stop_at ? 1 : 0;
+}
+
+TEST(ChunkedListNumaTest, SimulatedPlacement) {
+    chunked_list_numa_simulate(4);
+    EXPECT_EQ(chunked_list_numa_node_count(), 4);
+
+    // Chunks larger than a page are placed one by one
+    CHUNKED_LIST_HANDLE list = chunked_list_create(sizeof(int), 4096);
+    EXPECT_EQ(chunked_list_set_numa_policy(list, CHUNKED_LIST_NUMA_BIND, 4), CHUNKED_LIST_ERROR_INVALID_INDEX);
+    EXPECT_EQ(chunked_list_set_numa_policy(list, 3, 0), CHUNKED_LIST_ERROR_INVALID_OPERATION);
+    ASSERT_EQ(chunked_list_set_numa_policy(list, CHUNKED_LIST_NUMA_INTERLEAVE, 0), CHUNKED_LIST_SUCCESS);
+    const int COUNT = 40 * 1024;
+    for (int idx = 0; idx < COUNT; ++idx) {
+        ASSERT_EQ(chunked_list_add(list, &idx), CHUNKED_LIST_SUCCESS);
+    }
+    size_t counts[4];
+    EXPECT_EQ(chunked_list_numa_chunks(list, counts, 4), 40UL);
+    for (size_t node = 0; node < 4; ++node) {
+        EXPECT_EQ(counts[node], 10UL);
+    }
+#ifdef CHUNKED_LIST_ENABLE_STATS
+    CHUNKED_LIST_STATS stats;
+    ASSERT_EQ(chunked_list_get_stats(list, &stats), CHUNKED_LIST_SUCCESS);
+    EXPECT_LE(stats.chunk_allocations, 20UL);  // Batches of one slab per node, not one per chunk
+#endif
+
+    // Reserved chunks follow the policy too
+    ASSERT_EQ(chunked_list_set_numa_policy(list, CHUNKED_LIST_NUMA_BIND, 2), CHUNKED_LIST_SUCCESS);
+    ASSERT_EQ(chunked_list_reserve(list, COUNT + 8 * 1024), CHUNKED_LIST_SUCCESS);
+    for (int idx = COUNT; idx < COUNT + 8 * 1024; ++idx) {
+        ASSERT_EQ(chunked_list_add(list, &idx), CHUNKED_LIST_SUCCESS);
+    }
+    EXPECT_EQ(chunked_list_numa_chunks(list, counts, 4), 48UL);
+    EXPECT_EQ(counts[2], 18UL);
+
+    // Every item is visited once with its index, also when a compressed chunk is restored first
+    size_t compressed;
+    ASSERT_EQ(chunked_list_compress_cold(list, 0, &compressed), CHUNKED_LIST_SUCCESS);
+    EXPECT_GT(compressed, 0UL);
+    ParallelScan scan;
+    ASSERT_EQ(chunked_list_scan_parallel(list, 2, check_index, &scan), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(scan.visited.load(), (size_t)COUNT + 8 * 1024);
+    EXPECT_EQ(scan.mismatches.load(), 0UL);
+
+    ParallelScan stopped;
+    stopped.stop_at = 5;
+    ASSERT_EQ(chunked_list_scan_parallel(list, 1, check_index, &stopped), CHUNKED_LIST_SUCCESS);
+    EXPECT_LT(stopped.visited.load(), (size_t)COUNT);
+
+    chunked_list_destroy(list);
+    chunked_list_numa_simulate(0);
+}
+
+TEST(ChunkedListSlotsTest, StableHandles) {
+    EXPECT_EQ(chunked_list_create_ex(sizeof(int), 256, CHUNKED_LIST_FLAG_SLOT_MAP | CHUNKED_LIST_FLAG_READER_SAFE), nullptr);
+    EXPECT_EQ(chunked_list_create_ex(sizeof(int), 4, CHUNKED_LIST_FLAG_SLOT_MAP), nullptr);  // No room for a slot
+    CHUNKED_LIST_HANDLE list = chunked_list_create_ex(sizeof(int), 256, CHUNKED_LIST_FLAG_SLOT_MAP);
+    ASSERT_NE(list, nullptr);
+    EXPECT_EQ(chunked_list_flags(list), (unsigned)CHUNKED_LIST_FLAG_SLOT_MAP);
+
+    const int COUNT = 100;
+    std::vector<CHUNKED_LIST_SLOT_HANDLE> handles(COUNT);
+    std::vector<int*> items(COUNT);
+    for (int idx = 0; idx < COUNT; ++idx) {
+        ASSERT_EQ(chunked_list_add_slot(list, &idx, &handles[idx]), CHUNKED_LIST_SUCCESS);
+        ASSERT_NE(handles[idx], CHUNKED_LIST_INVALID_SLOT_HANDLE);
+        ASSERT_EQ(chunked_list_at_slot(list, handles[idx], (void**)&items[idx]), CHUNKED_LIST_SUCCESS);
+    }
+
+    // Removing leaves the other items, their handles and addresses alone
+    EXPECT_EQ(chunked_list_remove_slot(list, handles[10]), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(chunked_list_remove_slot(list, handles[10]), CHUNKED_LIST_ERROR_INVALID_INDEX);
+    EXPECT_EQ(chunked_list_remove(list, 50), CHUNKED_LIST_SUCCESS);  // Item 51 by position
+    EXPECT_EQ(chunked_list_count(list), (size_t)COUNT - 2);
+    int* item;
+    EXPECT_EQ(chunked_list_at_slot(list, handles[10], (void**)&item), CHUNKED_LIST_ERROR_INVALID_INDEX);
+    EXPECT_EQ(chunked_list_at_slot(list, handles[51], (void**)&item), CHUNKED_LIST_ERROR_INVALID_INDEX);
+    EXPECT_EQ(chunked_list_at_slot(list, handles[99], (void**)&item), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(item, items[99]);
+    EXPECT_EQ(chunked_list_at(list, 10, (void**)&item), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(*item, 11);
+
+    // New items fill the free slots, stale handles do not see them
+    int value = 1000;
+    CHUNKED_LIST_SLOT_HANDLE reused;
+    ASSERT_EQ(chunked_list_add_slot(list, &value, &reused), CHUNKED_LIST_SUCCESS);
+    EXPECT_NE(reused, handles[51]);
+    EXPECT_EQ(chunked_list_at_slot(list, reused, (void**)&item), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(item, items[51]);
+    EXPECT_EQ(chunked_list_at_slot(list, handles[51], (void**)&item), CHUNKED_LIST_ERROR_INVALID_INDEX);
+    EXPECT_EQ(chunked_list_expand(list, (void**)&item), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(item, items[10]);
+    *item = 2000;
+#ifdef CHUNKED_LIST_ENABLE_STATS
+    CHUNKED_LIST_STATS stats;
+    EXPECT_EQ(chunked_list_get_stats(list, &stats), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(stats.add_count, (size_t)COUNT + 1);
+    EXPECT_EQ(stats.remove_count, 2UL);  // Not the second removal of handles[10]
+    EXPECT_EQ(stats.expand_count, (size_t)COUNT + 2);  // Reused slots count too
+#endif
+
+    // The iterator skips free slots and reports the handles
+    EXPECT_EQ(chunked_list_remove_slot(list, handles[0]), CHUNKED_LIST_SUCCESS);
+    CHUNKED_LIST_ITERATOR_HANDLE iter = chunked_list_iterator_create(list);
+    size_t visited = 0;
+    while (chunked_list_iterator_is_end(iter) != 1) {
+        CHUNKED_LIST_SLOT_HANDLE handle;
+        ASSERT_EQ(chunked_list_iterator_get(iter, (void**)&item), CHUNKED_LIST_ITERATOR_SUCCESS);
+        ASSERT_EQ(chunked_list_iterator_get_slot(iter, &handle), CHUNKED_LIST_ITERATOR_SUCCESS);
+        ASSERT_NE(*item, 0);
+        int* by_handle;
+        ASSERT_EQ(chunked_list_at_slot(list, handle, (void**)&by_handle), CHUNKED_LIST_SUCCESS);
+        ASSERT_EQ(by_handle, item);
+        visited++;
+        ASSERT_EQ(chunked_list_iterator_next(iter), CHUNKED_LIST_ITERATOR_SUCCESS);
+    }
+    size_t length;
+    EXPECT_EQ(chunked_list_iterator_get_bytes(iter, (void**)&item, &length), CHUNKED_LIST_ITERATOR_ERROR_INVALID_OPERATION);
+    chunked_list_iterator_destroy(iter);
+    EXPECT_EQ(visited, chunked_list_count(list));
+    EXPECT_EQ(visited, (size_t)COUNT - 1);
+
+    // Operations relying on positions of items are rejected
+    EXPECT_EQ(chunked_list_insert(list, 0, (void**)&item), CHUNKED_LIST_ERROR_INVALID_OPERATION);
+    EXPECT_EQ(chunked_list_set_key_extractor(list, int_key), CHUNKED_LIST_ERROR_INVALID_OPERATION);
+    EXPECT_EQ(chunked_list_snapshot(list), nullptr);
+
+    // Handles of cleared items stay invalid when their slots are used again
+    EXPECT_EQ(chunked_list_clear(list), CHUNKED_LIST_SUCCESS);
+    for (int idx = 0; idx < COUNT; ++idx) {
+        ASSERT_EQ(chunked_list_add(list, &idx), CHUNKED_LIST_SUCCESS);
+    }
+    EXPECT_EQ(chunked_list_at_slot(list, handles[5], (void**)&item), CHUNKED_LIST_ERROR_INVALID_INDEX);
+
+    chunked_list_destroy(list);
+}
+
+TEST(ChunkedListLayoutTest, Relayout) {
+    CHUNKED_LIST_HANDLE list = chunked_list_create(sizeof(int), 16 * sizeof(int));
+    ASSERT_NE(list, nullptr);
+
+    // Allocations in between scatter the chunks over the heap
+    const int COUNT = 200;
+    std::vector<void*> scattered;
+    for (int idx = 0; idx < COUNT; ++idx) {
+        ASSERT_EQ(chunked_list_add(list, &idx), CHUNKED_LIST_SUCCESS);
+        if (idx % 16 == 0) {
+            scattered.push_back(malloc(100 + idx));
+        }
+    }
+    for (int idx = 0; idx < 16; ++idx) {
+        ASSERT_EQ(chunked_list_remove(list, 16), CHUNKED_LIST_SUCCESS);  // Empties the second chunk
+    }
+
+    // Shared chunks stay where they are
+    CHUNKED_LIST_HANDLE snapshot = chunked_list_snapshot(list);
+    ASSERT_NE(snapshot, nullptr);
+    size_t relocated = 1;
+    EXPECT_EQ(chunked_list_relayout(list, &relocated), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(relocated, 0UL);
+    chunked_list_destroy(snapshot);
+
+    EXPECT_EQ(chunked_list_relayout(list, &relocated), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(relocated, 12UL);
+    EXPECT_EQ(chunked_list_count(list), (size_t)COUNT - 16);
+    char* previous = nullptr;
+    CHUNKED_LIST_ITERATOR_HANDLE iter = chunked_list_iterator_create(list);
+    while (chunked_list_iterator_is_end(iter) != 1) {
+        int* item;
+        ASSERT_EQ(chunked_list_iterator_get(iter, (void**)&item), CHUNKED_LIST_ITERATOR_SUCCESS);
+        size_t index = chunked_list_iterator_get_index(iter);
+        EXPECT_EQ(*item, (int)(index < 16 ? index : index + 16));
+        EXPECT_GT((char*)item, previous);  // Ascending addresses along the chain
+        previous = (char*)item;
+        ASSERT_EQ(chunked_list_iterator_next(iter), CHUNKED_LIST_ITERATOR_SUCCESS);
+    }
+    chunked_list_iterator_destroy(iter);
+
+    // Appending continues behind the moved tail
+    int value = COUNT;
+    EXPECT_EQ(chunked_list_add(list, &value), CHUNKED_LIST_SUCCESS);
+    int* item;
+    EXPECT_EQ(chunked_list_at(list, COUNT - 16, (void**)&item), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(*item, COUNT);
+    chunked_list_destroy(list);
+    for (void* block : scattered) {
+        free(block);
+    }
+
+    // Handles of a slot map follow their items
+    list = chunked_list_create_ex(sizeof(int), 256, CHUNKED_LIST_FLAG_SLOT_MAP);
+    std::vector<CHUNKED_LIST_SLOT_HANDLE> handles(100);
+    for (int idx = 0; idx < 100; ++idx) {
+        ASSERT_EQ(chunked_list_add_slot(list, &idx, &handles[idx]), CHUNKED_LIST_SUCCESS);
+    }
+    EXPECT_EQ(chunked_list_remove_slot(list, handles[42]), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(chunked_list_relayout(list, &relocated), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(relocated, 4UL);
+    for (int idx = 0; idx < 100; ++idx) {
+        int result = chunked_list_at_slot(list, handles[idx], (void**)&item);
+        if (idx == 42) {
+            EXPECT_EQ(result, CHUNKED_LIST_ERROR_INVALID_INDEX);
+        } else {
+            ASSERT_EQ(result, CHUNKED_LIST_SUCCESS);
+            EXPECT_EQ(*item, idx);
+        }
+    }
+    EXPECT_EQ(chunked_list_add_slot(list, &value, &handles[42]), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(chunked_list_at(list, 42, (void**)&item), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(*item, COUNT);
+    chunked_list_destroy(list);
+
+    // Items larger than a chunk keep their own chunk
+    list = chunked_list_create_ex(0, 256, CHUNKED_LIST_FLAG_VARIABLE_LENGTH);
+    std::string large(1000, 'x');
+    ASSERT_EQ(chunked_list_add_bytes(list, "abc", 3), CHUNKED_LIST_SUCCESS);
+    ASSERT_EQ(chunked_list_add_bytes(list, large.data(), large.size()), CHUNKED_LIST_SUCCESS);
+    ASSERT_EQ(chunked_list_add_bytes(list, "def", 3), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(chunked_list_relayout(list, &relocated), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(relocated, 2UL);
+    const char* expected[] = { "abc", large.c_str(), "def" };
+    for (size_t idx = 0; idx < 3; ++idx) {
+        char* bytes;
+        size_t length;
+        ASSERT_EQ(chunked_list_at_bytes(list, idx, (void**)&bytes, &length), CHUNKED_LIST_SUCCESS);
+        EXPECT_EQ(std::string(bytes, length), expected[idx]);
+    }
+    chunked_list_destroy(list);
+
+    // Readers keep reading the old chunks until they leave
+    list = chunked_list_create_ex(sizeof(int), 64, CHUNKED_LIST_FLAG_READER_SAFE);
+    for (int idx = 0; idx < 100; ++idx) {
+        ASSERT_EQ(chunked_list_add(list, &idx), CHUNKED_LIST_SUCCESS);
+    }
+    CHUNKED_LIST_READER_HANDLE reader = chunked_list_reader_register(list);
+    chunked_list_reader_enter(reader);
+    ASSERT_EQ(chunked_list_at(list, 50, (void**)&item), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(chunked_list_relayout(list, &relocated), CHUNKED_LIST_SUCCESS);
+    EXPECT_EQ(relocated, 7UL);
+    EXPECT_EQ(*item, 50);
+    EXPECT_GT(chunked_list_reclaim(list), 0UL);
+    chunked_list_reader_exit(reader);
+    EXPECT_EQ(chunked_list_reclaim(list), 0UL);
+    chunked_list_reader_unregister(reader);
+    chunked_list_destroy(list);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -1,4 +1,8 @@
 #include "gtest/gtest.h"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "chunked_list.hpp"  // Include your chunked_list implementation header file
 
@@ -157,6 +161,283 @@ TEST_F(ChunkedListTest, AddAndRetrieveRemoveManyItem) {
     EXPECT_EQ(plist->at(COUNT - 2 - 1), COUNT - 1);
 }
 
+TEST_F(ChunkedListTest, ScanRange) {
+    EXPECT_THROW(plist->scan_range(0, 1, [](int&, size_t) {}), std::logic_error);
+
+    int COUNT = 1024 / sizeof(int) * 8;
+    for (int idx = 0; idx < COUNT; ++idx) {
+        plist->add(idx);
+    }
+    plist->set_key_extractor([](const void* item) -> int64_t { return *(const int*)item; });
+
+    int sum = 0;
+    size_t count = 0;
+    plist->scan_range(10, 19, [&](int& value, size_t index) {
+        EXPECT_EQ((size_t)value, index);
+        sum += value;
+        count++;
+    });
+    EXPECT_EQ(count, 10UL);
+    EXPECT_EQ(sum, 145);
+}
+
+TEST_F(ChunkedListTest, SortedInsertAndFind) {
+    int COUNT = 1024 / sizeof(int) * 6;
+
+    // Insert a permutation of 0..COUNT-1 in a scattered order
+    for (int idx = 0; idx < COUNT; ++idx) {
+        plist->insert_sorted((idx * 7919) % COUNT);
+    }
+    ASSERT_EQ(plist->size(), (size_t)COUNT);
+
+    int expected = 0;
+    for (int value : *plist) {
+        ASSERT_EQ(value, expected++);
+    }
+
+    EXPECT_EQ(plist->find(100), 100UL);
+    EXPECT_EQ(plist->find(COUNT), plist->size());
+    EXPECT_EQ(plist->find(-1), plist->size());
+
+    EXPECT_EQ(plist->insert_sorted(100), 101UL);
+    EXPECT_EQ(plist->lower_bound(100), 100UL);
+    EXPECT_EQ(plist->upper_bound(100), 102UL);
+
+    EXPECT_THROW(plist->insert(plist->size() + 1, 0), std::out_of_range);
+}
+
+TEST(ChunkedListSortedTest, CustomCompare) {
+    container::chunked_list::ChunkedList<int, std::greater<int>> list(64);
+
+    for (int idx = 0; idx < 100; ++idx) {
+        list.insert_sorted(idx);
+    }
+
+    EXPECT_EQ(list[0], 99);
+    EXPECT_EQ(list[99], 0);
+    EXPECT_EQ(list.find(90), 9UL);
+}
+
+TEST_F(ChunkedListTest, Stats) {
+    for (int idx = 0; idx < 1000; ++idx) {
+        plist->add(idx);
+    }
+
+    CHUNKED_LIST_STATS stats = plist->stats();
+    EXPECT_EQ(stats.chunk_count, 4UL);
+    EXPECT_EQ(stats.bytes_used, 1000 * sizeof(int));
+}
+
+TEST_F(ChunkedListTest, Reserve) {
+    plist->reserve(10000);
+    size_t capacity = plist->capacity();
+    EXPECT_GE(capacity, 10000UL);
+
+    for (int idx = 0; idx < 10000; ++idx) {
+        plist->add(idx);
+    }
+    EXPECT_EQ(plist->capacity(), capacity);
+    EXPECT_EQ(plist->at(9999), 9999);
+}
+
+TEST_F(ChunkedListTest, Snapshot) {
+    for (int idx = 0; idx < 1000; ++idx) {
+        plist->add(idx);
+    }
+
+    auto snapshot = plist->snapshot();
+    plist->remove(0);
+    plist->at(100) = -1;  // The first chunk was copied by the removal above
+    plist->add(1000);
+
+    EXPECT_EQ(snapshot.size(), 1000UL);
+    int expected = 0;
+    for (int value : snapshot) {
+        ASSERT_EQ(value, expected++);
+    }
+    EXPECT_EQ(plist->at(0), 1);
+}
+
+TEST(ChunkedListCompressTest, CompressCold) {
+    struct Event {
+        int64_t timestamp;
+        int64_t delta;
+        uint32_t kind;
+        uint32_t flags;
+    };
+    container::chunked_list::ChunkedList<Event> events(1024);
+    int64_t timestamp = 1700000000000LL;
+    for (int idx = 0; idx < 1000; ++idx) {
+        timestamp += idx % 3;
+        events.add(Event{ timestamp, -(idx % 5), 7, 0 });
+    }
+
+    EXPECT_EQ(events.compress_cold(), 1000UL / (1024 / sizeof(Event)));
+    EXPECT_GE(events.stats().compression_ratio, 2.0);
+
+    timestamp = 1700000000000LL;
+    int idx = 0;
+    for (const Event& event : events) {
+        timestamp += idx % 3;
+        ASSERT_EQ(event.timestamp, timestamp);
+        ASSERT_EQ(event.delta, -(idx % 5));
+        ASSERT_EQ(event.kind, 7U);
+        idx++;
+    }
+    EXPECT_EQ(events.stats().compressed_chunks, 0UL);
+}
+
+TEST(ChunkedByteListTest, AddAndIterate) {
+    container::chunked_list::ChunkedByteList list(64);
+    list.add("alpha");
+    list.add("");
+    list.add(std::string(100, 'x'));  // Larger than a chunk
+    list.add("omega");
+
+    EXPECT_EQ(list.size(), 4UL);
+    EXPECT_EQ(list[0], "alpha");
+    EXPECT_EQ(list[1], "");
+    EXPECT_EQ(list[2].size(), 100UL);
+    EXPECT_THROW(list.at(4), std::out_of_range);
+
+    auto snapshot = list.snapshot();
+    list.remove(0);
+    EXPECT_EQ(list[0], "");
+    EXPECT_EQ(snapshot[0], "alpha");
+
+    std::string joined;
+    for (std::string_view item : list) {
+        joined += item.substr(0, 1);
+    }
+    EXPECT_EQ(joined, "xo");
+}
+
+TEST(ChunkedListReadersTest, ConcurrentReaders) {
+    using List = container::chunked_list::ChunkedList<int>;
+    List list(256, CHUNKED_LIST_FLAG_READER_SAFE);
+    EXPECT_THROW(list.insert(0, 1), std::logic_error);
+    List plain(256);
+    EXPECT_THROW(List::reader{ plain }, std::runtime_error);
+
+    // Only reader-safe lists fall back to add, other unsupported modes report the misuse
+    List bytes(256);
+    bytes.attach(chunked_list_create_ex(0, 256, CHUNKED_LIST_FLAG_VARIABLE_LENGTH), true);
+    EXPECT_THROW(bytes.emplace(1), std::logic_error);
+
+    // Readers see ascending items while the writer appends and removes
+    std::atomic<bool> done(false);
+    std::atomic<int> errors(0);
+    std::vector<std::thread> readers;
+    for (int thread = 0; thread < 3; ++thread) {
+        readers.emplace_back([&list, &done, &errors] {
+            List::reader reader(list);
+            while (!done.load()) {
+                List::read_guard guard(reader);
+                int previous = -1;
+                for (int value : list) {
+                    if (value <= previous) {
+                        errors++;
+                    }
+                    previous = value;
+                }
+                if (list.size() > 0 && list.at(0) != 0) {  // The first item is never removed
+                    errors++;
+                }
+            }
+        });
+    }
+
+    const int COUNT = 20000;
+    for (int idx = 0; idx < COUNT; ++idx) {
+        list.emplace(idx);
+        if (idx % 4 == 3) {
+            list.remove(list.size() / 2);
+        }
+    }
+    done = true;
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(errors.load(), 0);
+    EXPECT_EQ(list.size(), (size_t)COUNT - COUNT / 4);
+    EXPECT_EQ(list.reclaim(), 0UL);
+}
+
+TEST(ChunkedListNumaTest, ScanParallel) {
+    chunked_list_numa_simulate(2);
+    container::chunked_list::ChunkedList<int64_t> list(1024);
+    list.set_numa_policy(CHUNKED_LIST_NUMA_INTERLEAVE);
+    EXPECT_THROW(list.set_numa_policy(CHUNKED_LIST_NUMA_BIND, 2), std::out_of_range);
+    for (int64_t idx = 0; idx < 10000; ++idx) {
+        list.add(idx);
+    }
+
+    std::atomic<int64_t> sum(0);
+    list.scan_parallel(4, [&sum](int64_t value, size_t) { sum += value; });
+    EXPECT_EQ(sum.load(), 10000LL * 9999 / 2);
+    chunked_list_numa_simulate(0);
+}
+
+TEST(ChunkedListSlotsTest, Handles) {
+    container::chunked_list::ChunkedList<std::string> names(1024, CHUNKED_LIST_FLAG_SLOT_MAP);
+    CHUNKED_LIST_SLOT_HANDLE alpha = names.emplace_slot("alpha");
+    CHUNKED_LIST_SLOT_HANDLE beta = names.emplace_slot("beta");
+    CHUNKED_LIST_SLOT_HANDLE gamma = names.emplace_slot("gamma");
+
+    names.at_slot(alpha).~basic_string();
+    names.remove_slot(alpha);
+    EXPECT_FALSE(names.contains_slot(alpha));
+    EXPECT_THROW(names.at_slot(alpha), std::out_of_range);
+    EXPECT_EQ(names.at_slot(gamma), "gamma");
+
+    CHUNKED_LIST_SLOT_HANDLE delta = names.emplace_slot("delta");
+    EXPECT_EQ(&names.at_slot(delta), &names[0]);  // Took the slot of alpha
+    EXPECT_EQ(names.size(), 3UL);
+
+    std::string joined;
+    for (auto it = names.begin(); it != names.end(); ++it) {
+        EXPECT_EQ(&names.at_slot(it.slot()), &*it);
+        joined += *it;
+    }
+    EXPECT_EQ(joined, "deltabetagamma");
+    EXPECT_THROW(names.insert(0, "epsilon"), std::logic_error);
+    EXPECT_THROW(names.lower_bound("beta"), std::logic_error);
+    EXPECT_THROW(names.find("beta"), std::logic_error);
+    EXPECT_THROW(names.compress_cold(), std::logic_error);
+    EXPECT_THROW(names.set_key_extractor([](const void*) -> int64_t { return 0; }), std::logic_error);
+
+    for (CHUNKED_LIST_SLOT_HANDLE handle : { beta, gamma, delta }) {
+        names.at_slot(handle).~basic_string();
+    }
+}
+
+TEST(ChunkedListLayoutTest, Relayout) {
+    container::chunked_list::ChunkedList<int64_t> list(64);
+    for (int64_t idx = 0; idx < 1001; ++idx) {
+        list.add(idx);
+    }
+    for (int idx = 0; idx < 8; ++idx) {
+        list.remove(0);  // Empties the first chunk
+    }
+    EXPECT_EQ(list.stats().empty_chunks, 1UL);
+
+    // Compressed chunks stay where they are
+    size_t compressed = list.compress_cold();
+    EXPECT_EQ(compressed, 124UL);
+    EXPECT_EQ(list.relayout(), 1UL);  // Only the tail
+    EXPECT_EQ(list.stats().empty_chunks, 0UL);
+    EXPECT_EQ(list.stats().compressed_chunks, compressed);
+
+    int64_t expected = 8;
+    for (int64_t value : list) {
+        EXPECT_EQ(value, expected++);
+    }
+    EXPECT_EQ(expected, 1001);
+    EXPECT_EQ(list.relayout(), 125UL);  // Iterating decompressed all chunks
+    EXPECT_EQ(list[500], 508);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();